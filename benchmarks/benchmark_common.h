@@ -0,0 +1,116 @@
+/**
+
+    @file      benchmark_common.h
+    @brief     Benchmarks registration and running
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+#pragma once
+
+#include <qx/pvs_config.h>
+#include <qx/stat/benchmark.h>
+
+#include <format>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace qx::benchmarks
+{
+
+/**
+
+    @class   context
+    @brief   Runs benchmark cases of a benchmark function and collects their results
+    @author  Khrapov
+    @date    17.10.2026
+
+**/
+class context
+{
+public:
+    /**
+        @brief context object constructor
+        @param options  - options of all runs
+        @param svFilter - substring a case name must contain to be run, empty - run all cases
+    **/
+    context(const benchmark_options& options, std::string_view svFilter) : m_Options(options), m_svFilter(svFilter)
+    {
+    }
+
+    /**
+        @brief  Measure a benchmark case
+        @tparam func_t - function type, void()
+        @param  svName - case name, "group/case/implementation" by convention
+        @param  func   - function to measure, one call is one iteration
+    **/
+    template<class func_t>
+    void run(std::string_view svName, func_t&& func)
+    {
+        if (!m_svFilter.empty() && svName.find(m_svFilter) == std::string_view::npos)
+            return;
+
+        const benchmark_result& result = m_Results.emplace_back(benchmark::run(svName, func, m_Options));
+
+        std::cerr << std::format(
+            "{:<56} {:>12.2f} ns {:>10.2f} ns stddev {:>3} outliers\n",
+            result.sName,
+            result.fMedian,
+            result.fStdDev,
+            result.nOutliers);
+    }
+
+    /**
+        @brief  Get results of all run cases
+        @retval  - benchmark results
+    **/
+    const std::vector<benchmark_result>& get_results() const noexcept
+    {
+        return m_Results;
+    }
+
+private:
+    benchmark_options             m_Options;
+    std::string_view              m_svFilter;
+    std::vector<benchmark_result> m_Results;
+};
+
+using benchmark_function = void (*)(context& context);
+
+struct registered_benchmark
+{
+    std::string_view   svName;
+    benchmark_function pFunction = nullptr;
+};
+
+inline std::vector<registered_benchmark>& get_registered_benchmarks()
+{
+    static std::vector<registered_benchmark> benchmarks;
+    return benchmarks;
+}
+
+struct benchmark_registrator
+{
+    benchmark_registrator(std::string_view svName, benchmark_function pFunction)
+    {
+        get_registered_benchmarks().push_back({ svName, pFunction });
+    }
+};
+
+} // namespace qx::benchmarks
+
+/**
+    @def   QX_BENCHMARK
+    @brief Define and register a benchmark function, use context.run() inside to measure cases
+    @param group - benchmark group
+    @param name  - benchmark name
+**/
+#define QX_BENCHMARK(group, name)                                                                       \
+    static void qx_benchmark_##group##_##name(qx::benchmarks::context& context);                        \
+    static const qx::benchmarks::benchmark_registrator qx_benchmark_registrator_##group##_##name(       \
+        #group "/" #name,                                                                               \
+        qx_benchmark_##group##_##name);                                                                 \
+    static void qx_benchmark_##group##_##name(qx::benchmarks::context& context)
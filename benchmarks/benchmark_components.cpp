@@ -0,0 +1,129 @@
+/**
+
+    @file      benchmark_components.cpp
+    @brief     components::view iteration
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+#include <benchmark_common.h>
+
+#include <qx/containers/components.h>
+
+namespace
+{
+
+class base_benchmark_component : public qx::rtti_root<>
+{
+    QX_RTTI_CLASS(base_benchmark_component, qx::rtti_root<>);
+
+public:
+    virtual int get_value() const = 0;
+};
+
+class benchmark_component_a : public base_benchmark_component
+{
+    QX_RTTI_CLASS(benchmark_component_a, base_benchmark_component);
+
+public:
+    explicit benchmark_component_a(int nValue) : m_nValue(nValue)
+    {
+    }
+
+    virtual int get_value() const override
+    {
+        return m_nValue;
+    }
+
+private:
+    int m_nValue = 0;
+};
+
+class benchmark_component_b : public base_benchmark_component
+{
+    QX_RTTI_CLASS(benchmark_component_b, base_benchmark_component);
+
+public:
+    explicit benchmark_component_b(int nValue) : m_nValue(nValue)
+    {
+    }
+
+    virtual int get_value() const override
+    {
+        return -m_nValue;
+    }
+
+private:
+    int m_nValue = 0;
+};
+
+class benchmark_component_b1 : public benchmark_component_b
+{
+    QX_RTTI_CLASS(benchmark_component_b1, benchmark_component_b);
+
+public:
+    using benchmark_component_b::benchmark_component_b;
+};
+
+template<class component_t>
+int sum_values(const qx::components<base_benchmark_component>& components)
+{
+    int nSum = 0;
+    for (const auto& component : components.view<component_t>())
+        nSum += component.get_value();
+
+    return nSum;
+}
+
+} // namespace
+
+QX_BENCHMARK(components, view)
+{
+    constexpr qx::priority k_Priorities[] = { qx::priority::low, qx::priority::normal, qx::priority::high };
+
+    for (const int nComponents : { 16, 1024 })
+    {
+        qx::components<base_benchmark_component> components;
+        for (int i = 0; i < nComponents; ++i)
+        {
+            const qx::priority ePriority = k_Priorities[i % std::size(k_Priorities)];
+
+            switch (i % 3)
+            {
+            case 0:
+                components.add(std::make_unique<benchmark_component_a>(i), ePriority);
+                break;
+
+            case 1:
+                components.add(std::make_unique<benchmark_component_b>(i), ePriority);
+                break;
+
+            default:
+                components.add(std::make_unique<benchmark_component_b1>(i), ePriority);
+                break;
+            }
+        }
+
+        context.run(
+            std::format("components/view_all/{}", nComponents),
+            [&]
+            {
+                qx::benchmark::do_not_optimize(sum_values<base_benchmark_component>(components));
+            });
+
+        context.run(
+            std::format("components/view_final_class/{}", nComponents),
+            [&]
+            {
+                qx::benchmark::do_not_optimize(sum_values<benchmark_component_a>(components));
+            });
+
+        context.run(
+            std::format("components/view_base_class/{}", nComponents),
+            [&]
+            {
+                qx::benchmark::do_not_optimize(sum_values<benchmark_component_b>(components));
+            });
+    }
+}
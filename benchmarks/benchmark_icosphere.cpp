@@ -0,0 +1,42 @@
+/**
+
+    @file      benchmark_icosphere.cpp
+    @brief     create_icosphere generation
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+#include <benchmark_common.h>
+
+#include <qx/render/geom.h>
+
+QX_BENCHMARK(geom, create_icosphere)
+{
+    for (size_t nDivides = 0; nDivides <= 4; ++nDivides)
+    {
+        context.run(
+            std::format("geom/create_icosphere/{}_divides/smooth", nDivides),
+            [nDivides]
+            {
+                const qx::geometry geometry = qx::create_icosphere(1.f, nDivides, false);
+                qx::benchmark::do_not_optimize(geometry.geomVertices.data());
+            });
+
+        context.run(
+            std::format("geom/create_icosphere/{}_divides/flat", nDivides),
+            [nDivides]
+            {
+                const qx::geometry geometry = qx::create_icosphere(1.f, nDivides, true);
+                qx::benchmark::do_not_optimize(geometry.geomVertices.data());
+            });
+    }
+
+    context.run(
+        "geom/create_icosphere_lines/3_divides",
+        []
+        {
+            const qx::geometry geometry = qx::create_icosphere_lines(1.f, 3);
+            qx::benchmark::do_not_optimize(geometry.geomVertices.data());
+        });
+}
@@ -0,0 +1,128 @@
+/**
+
+    @file      benchmark_logger.cpp
+    @brief     Logger throughput
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+#include <benchmark_common.h>
+
+#include <qx/logger/logger.h>
+
+#include <atomic>
+#include <thread>
+
+namespace
+{
+
+// formats lines as usual but drops them, so that the benchmark doesn't measure console or disk speed
+class null_logger_stream : public qx::base_logger_stream
+{
+public:
+    null_logger_stream() : base_logger_stream(false)
+    {
+    }
+
+    virtual void flush() override
+    {
+    }
+
+private:
+    virtual void do_log(
+        qx::string_view                            svMessage,
+        const qx::log_unit&                        logUnit,
+        const std::vector<qx::logger_color_range>& colors,
+        qx::verbosity                              eVerbosity) override
+    {
+        qx::benchmark::do_not_optimize(svMessage.data());
+    }
+};
+
+void log_message(qx::logger& logger, qx::verbosity eVerbosity, int nValue)
+{
+    logger.log(
+        eVerbosity,
+        QX_TEXT("value {} of {} is {}"),
+        CatDefault,
+        QX_TEXT("benchmark_logger.cpp"),
+        QX_TEXT("log_message"),
+        __LINE__,
+        nValue,
+        1.5f,
+        QX_TEXT("string"));
+}
+
+} // namespace
+
+QX_BENCHMARK(logger, single_thread)
+{
+    qx::logger logger;
+
+    auto pStream = std::make_unique<null_logger_stream>();
+    pStream->deregister_unit(qx::base_logger_stream::k_svDefaultUnit);
+    pStream->register_unit(qx::base_logger_stream::k_svDefaultUnit, { qx::verbosity::warning });
+    logger.add_stream(std::move(pStream));
+
+    int nValue = 0;
+
+    context.run(
+        "logger/accepted/1_stream",
+        [&]
+        {
+            log_message(logger, qx::verbosity::warning, ++nValue);
+        });
+
+    context.run(
+        "logger/rejected/1_stream",
+        [&]
+        {
+            log_message(logger, qx::verbosity::verbose, ++nValue);
+        });
+
+    logger.add_stream(std::make_unique<null_logger_stream>());
+    logger.add_stream(std::make_unique<null_logger_stream>());
+
+    context.run(
+        "logger/accepted/3_streams",
+        [&]
+        {
+            log_message(logger, qx::verbosity::warning, ++nValue);
+        });
+}
+
+QX_BENCHMARK(logger, contended)
+{
+    // one thread is the uncontended baseline, formatting serialization shows up on the biggest counts
+    for (int nThreads = 1; nThreads <= 64; nThreads *= 2)
+    {
+        qx::logger logger;
+        logger.add_stream(std::make_unique<null_logger_stream>());
+
+        // background threads keep the stream busy while the measured thread logs
+        std::atomic<bool>        bStop = false;
+        std::vector<std::thread> threads;
+        for (int i = 1; i < nThreads; ++i)
+        {
+            threads.emplace_back(
+                [&logger, &bStop]
+                {
+                    for (int nValue = 0; !bStop; ++nValue)
+                        log_message(logger, qx::verbosity::important, nValue);
+                });
+        }
+
+        int nValue = 0;
+        context.run(
+            std::format("logger/accepted/{}_threads", nThreads),
+            [&]
+            {
+                log_message(logger, qx::verbosity::important, ++nValue);
+            });
+
+        bStop = true;
+        for (auto& thread : threads)
+            thread.join();
+    }
+}
@@ -0,0 +1,158 @@
+/**
+
+    @file      benchmark_sort.cpp
+    @brief     qx::sort_* compared with std::sort and std::stable_sort
+    @details   Each iteration copies unsorted data and sorts the copy, the copy cost is the same for all algorithms
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+#include <benchmark_common.h>
+
+#include <qx/algo/sort.h>
+
+#include <algorithm>
+#include <random>
+
+namespace
+{
+
+std::vector<int> create_data(size_t nSize, int nMaxValue)
+{
+    std::mt19937                       generator(42);
+    std::uniform_int_distribution<int> distribution(0, nMaxValue);
+
+    std::vector<int> data(nSize);
+    for (int& nValue : data)
+        nValue = distribution(generator);
+
+    return data;
+}
+
+template<class sort_func_t>
+void run_sort(
+    qx::benchmarks::context& context,
+    std::string_view         svCase,
+    std::string_view         svImpl,
+    const std::vector<int>&  source,
+    sort_func_t              sortFunc)
+{
+    std::vector<int> data(source.size());
+
+    context.run(
+        std::format("sort/{}/{}", svCase, svImpl),
+        [&]
+        {
+            std::ranges::copy(source, data.begin());
+            sortFunc(data);
+            qx::benchmark::do_not_optimize(data.data());
+        });
+}
+
+void run_sort_cases(qx::benchmarks::context& context, std::string_view svCase, const std::vector<int>& source)
+{
+    run_sort(context, svCase, "std::sort", source, [](std::vector<int>& data) { std::sort(data.begin(), data.end()); });
+
+    run_sort(
+        context,
+        svCase,
+        "std::stable_sort",
+        source,
+        [](std::vector<int>& data)
+        {
+            std::stable_sort(data.begin(), data.end());
+        });
+
+    run_sort(context, svCase, "qx::sort", source, [](std::vector<int>& data) { qx::sort(data); });
+
+    run_sort(
+        context,
+        svCase,
+        "qx::sort_quick_hoare",
+        source,
+        [](std::vector<int>& data)
+        {
+            qx::sort_quick_hoare(data);
+        });
+
+    run_sort(
+        context,
+        svCase,
+        "qx::sort_quick_three_way",
+        source,
+        [](std::vector<int>& data)
+        {
+            qx::sort_quick_three_way(data);
+        });
+
+    run_sort(
+        context,
+        svCase,
+        "qx::sort_quick_dual_pivot",
+        source,
+        [](std::vector<int>& data)
+        {
+            qx::sort_quick_dual_pivot(data);
+        });
+
+    run_sort(context, svCase, "qx::sort_heap", source, [](std::vector<int>& data) { qx::sort_heap(data); });
+
+    std::vector<int> mergeBuffer(source.size());
+    run_sort(
+        context,
+        svCase,
+        "qx::sort_merge",
+        source,
+        [&mergeBuffer](std::vector<int>& data)
+        {
+            qx::sort_merge(data, std::less<>(), &mergeBuffer);
+        });
+
+    run_sort(
+        context,
+        svCase,
+        "qx::sort_counting",
+        source,
+        [](std::vector<int>& data)
+        {
+            static_cast<void>(qx::sort_counting(data));
+        });
+
+    if (source.size() <= 1000)
+    {
+        run_sort(
+            context,
+            svCase,
+            "qx::sort_insertion",
+            source,
+            [](std::vector<int>& data)
+            {
+                qx::sort_insertion(data);
+            });
+    }
+}
+
+} // namespace
+
+QX_BENCHMARK(sort, random)
+{
+    run_sort_cases(context, "random_100", create_data(100, 1 << 20));
+    run_sort_cases(context, "random_10k", create_data(10000, 1 << 20));
+    run_sort_cases(context, "random_1m", create_data(1000000, 1 << 20));
+}
+
+QX_BENCHMARK(sort, few_unique)
+{
+    run_sort_cases(context, "few_unique_10k", create_data(10000, 16));
+}
+
+QX_BENCHMARK(sort, sorted)
+{
+    std::vector<int> data = create_data(10000, 1 << 20);
+    std::ranges::sort(data);
+    run_sort_cases(context, "sorted_10k", data);
+
+    std::ranges::reverse(data);
+    run_sort_cases(context, "reversed_10k", data);
+}
@@ -0,0 +1,142 @@
+/**
+
+    @file      benchmark_string.cpp
+    @brief     qx::basic_string compared with std::basic_string
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+#include <benchmark_common.h>
+
+#include <qx/containers/string/string.h>
+
+#include <string>
+
+namespace
+{
+
+constexpr const char* k_pszShort = "short str";
+constexpr const char* k_pszLong  = "a long string which does not fit into the small string buffer of any implementation";
+
+// a multi-byte marker which is longer than k_nStringLongNeedleSize
+constexpr const char* k_pszMarker = "----- BEGIN PAYLOAD MARKER -----"
+                                    "----- 0123456789ABCDEF -----"
+                                    "----- END PAYLOAD MARKER -----";
+
+std::string create_text(size_t nSize)
+{
+    std::string sText;
+    sText.reserve(nSize);
+
+    for (size_t i = 0; sText.size() < nSize; ++i)
+        sText += static_cast<char>('a' + i * 7 % 23);
+
+    return sText;
+}
+
+template<class string_t>
+void run_string_cases(qx::benchmarks::context& context, std::string_view svImpl)
+{
+    context.run(
+        std::format("string/construct_short/{}", svImpl),
+        []
+        {
+            const string_t sStr(k_pszShort);
+            qx::benchmark::do_not_optimize(sStr);
+        });
+
+    context.run(
+        std::format("string/construct_long/{}", svImpl),
+        []
+        {
+            const string_t sStr(k_pszLong);
+            qx::benchmark::do_not_optimize(sStr);
+        });
+
+    context.run(
+        std::format("string/append_64/{}", svImpl),
+        []
+        {
+            string_t sStr;
+            for (int i = 0; i < 64; ++i)
+                sStr.append(k_pszShort);
+
+            qx::benchmark::do_not_optimize(sStr);
+        });
+
+    const std::string sStdText = create_text(4096);
+    const string_t    sText(sStdText.c_str());
+    const string_t    sCopyOfText(sStdText.c_str());
+
+    context.run(
+        std::format("string/compare_4k/{}", svImpl),
+        [&]
+        {
+            qx::benchmark::do_not_optimize(sText == sCopyOfText);
+        });
+
+    context.run(
+        std::format("string/find_char_4k/{}", svImpl),
+        [&]
+        {
+            qx::benchmark::do_not_optimize(sText.find('#'));
+        });
+
+    context.run(
+        std::format("string/rfind_char_4k/{}", svImpl),
+        [&]
+        {
+            qx::benchmark::do_not_optimize(sText.rfind('#'));
+        });
+
+    context.run(
+        std::format("string/find_first_of_4k/{}", svImpl),
+        [&]
+        {
+            qx::benchmark::do_not_optimize(sText.find_first_of("#$%"));
+        });
+
+    context.run(
+        std::format("string/find_last_of_4k/{}", svImpl),
+        [&]
+        {
+            qx::benchmark::do_not_optimize(sText.find_last_of("#$%"));
+        });
+
+    context.run(
+        std::format("string/find_short_4k/{}", svImpl),
+        [&]
+        {
+            qx::benchmark::do_not_optimize(sText.find("abc#"));
+        });
+
+    context.run(
+        std::format("string/find_long_4k/{}", svImpl),
+        [&]
+        {
+            qx::benchmark::do_not_optimize(sText.find("ahovcjqxelszgnubipwdkryfmtahovcjqxelszgnubip#"));
+        });
+
+    context.run(
+        std::format("string/find_marker_4k/{}", svImpl),
+        [&]
+        {
+            qx::benchmark::do_not_optimize(sText.find(k_pszMarker));
+        });
+
+    context.run(
+        std::format("string/rfind_marker_4k/{}", svImpl),
+        [&]
+        {
+            qx::benchmark::do_not_optimize(sText.rfind(k_pszMarker));
+        });
+}
+
+} // namespace
+
+QX_BENCHMARK(string, std_vs_qx)
+{
+    run_string_cases<std::string>(context, "std::string");
+    run_string_cases<qx::cstring>(context, "qx::cstring");
+}
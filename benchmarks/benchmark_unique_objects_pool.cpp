@@ -0,0 +1,61 @@
+/**
+
+    @file      benchmark_unique_objects_pool.cpp
+    @brief     unique_objects_pool lookups
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+#include <benchmark_common.h>
+
+#include <qx/containers/unique_objects_pool.h>
+
+#include <string>
+
+QX_BENCHMARK(unique_objects_pool, get_or_create)
+{
+    constexpr size_t k_nObjects = 1024;
+
+    std::vector<std::string> values;
+    for (size_t i = 0; i < k_nObjects; ++i)
+        values.push_back(std::format("unique object value #{}", i));
+
+    qx::unique_objects_pool<std::string>                 pool;
+    std::vector<qx::unique_objects_pool<std::string>::token> tokens;
+    for (const std::string& sValue : values)
+        tokens.push_back(pool.get_or_create(sValue));
+
+    size_t nValue = 0;
+
+    context.run(
+        "unique_objects_pool/get_existing/1k",
+        [&]
+        {
+            const auto token = pool.get_or_create(values[nValue++ % k_nObjects]);
+            qx::benchmark::do_not_optimize(token);
+        });
+
+    context.run(
+        "unique_objects_pool/dereference/1k",
+        [&]
+        {
+            qx::benchmark::do_not_optimize(tokens[nValue++ % k_nObjects]->size());
+        });
+
+    context.run(
+        "unique_objects_pool/create_and_release",
+        [&]
+        {
+            const auto token = pool.get_or_create(std::string("temporary unique object value"));
+            qx::benchmark::do_not_optimize(token);
+        });
+
+    context.run(
+        "unique_objects_pool/copy_token",
+        [&]
+        {
+            const auto token = tokens[nValue++ % k_nObjects];
+            qx::benchmark::do_not_optimize(token);
+        });
+}
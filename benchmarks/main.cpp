@@ -0,0 +1,80 @@
+/**
+
+    @file      main.cpp
+    @brief     Benchmarks entry point
+    @details   Usage: benchmark_<module> [--json=<file>] [--filter=<substring>] [--samples=<n>] [--quick] [--counters]
+               Results are written as JSON to stdout or to the given file, a human-readable summary goes to stderr
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+#include <benchmark_common.h>
+
+#include <charconv>
+#include <fstream>
+
+int main(int argc, char** argv)
+{
+    qx::benchmark_options options;
+    std::string_view      svFilter;
+    std::string_view      svJsonPath;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view svArg = argv[i];
+
+        if (svArg.starts_with("--json="))
+        {
+            svJsonPath = svArg.substr(std::string_view("--json=").size());
+        }
+        else if (svArg.starts_with("--filter="))
+        {
+            svFilter = svArg.substr(std::string_view("--filter=").size());
+        }
+        else if (svArg.starts_with("--samples="))
+        {
+            const std::string_view svSamples = svArg.substr(std::string_view("--samples=").size());
+            std::from_chars(svSamples.data(), svSamples.data() + svSamples.size(), options.nSamples);
+        }
+        else if (svArg == "--quick")
+        {
+            options.warmupTime = std::chrono::milliseconds(1);
+            options.sampleTime = std::chrono::milliseconds(1);
+            options.nSamples   = 5;
+        }
+        else if (svArg == "--counters")
+        {
+            options.bMeasureCycles           = true;
+            options.bMeasureHardwareCounters = true;
+        }
+        else
+        {
+            std::cerr << "Unknown argument: " << svArg << std::endl;
+            return 1;
+        }
+    }
+
+    qx::benchmarks::context context(options, svFilter);
+
+    for (const auto& benchmark : qx::benchmarks::get_registered_benchmarks())
+        benchmark.pFunction(context);
+
+    if (svJsonPath.empty())
+    {
+        qx::export_benchmark_json(std::cout, context.get_results());
+    }
+    else
+    {
+        std::ofstream file { std::string(svJsonPath) };
+        if (!file)
+        {
+            std::cerr << "Can't open " << svJsonPath << std::endl;
+            return 1;
+        }
+
+        qx::export_benchmark_json(file, context.get_results());
+    }
+
+    return 0;
+}
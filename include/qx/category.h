@@ -47,7 +47,7 @@ namespace qx
     @class   category
     @brief   A category is a class that identifies a particular piece of code.
              This code can be located in different files, but united by one functionality.
-             Objects of this class can be used in logging, asserts and profiling.
+             Objects of this class can be used in logging, asserts, profiling and metrics.
     @author  Khrapov
     @date    5.12.2022
 
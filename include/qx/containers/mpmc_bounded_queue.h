@@ -0,0 +1,124 @@
+/**
+
+    @file      mpmc_bounded_queue.h
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+#pragma once
+
+#include <qx/internal/cache_line.h>
+#include <qx/macros/copyable_movable.h>
+#include <qx/macros/suppress_warnings.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace qx
+{
+
+// positions are aligned to cache lines, so the class is padded (C4324)
+QX_PUSH_SUPPRESS_MSVC_WARNINGS(4324);
+
+/**
+
+    @class   mpmc_bounded_queue
+    @brief   Bounded lock-free multi-producer multi-consumer queue
+    @details Array based queue by Dmitry Vyukov. Every cell has a sequence number
+             which tells producers and consumers if the cell is ready to be written or read.
+             Cells are constructed once and then reused, so values owning memory (e.g. strings)
+             keep their capacity and don't allocate in steady state.
+             Class is thread safe
+    @tparam  T - value type, must be default constructible
+    @author  Khrapov
+    @date    17.10.2026
+
+**/
+template<class T>
+class mpmc_bounded_queue
+{
+    struct cell
+    {
+        std::atomic<size_t> nSequence = 0;
+        T                   value;
+    };
+
+public:
+    QX_NONCOPYMOVABLE(mpmc_bounded_queue);
+
+    /**
+        @brief mpmc_bounded_queue object constructor
+        @param nCapacity - max number of elements, will be rounded up to the power of 2
+    **/
+    explicit mpmc_bounded_queue(size_t nCapacity);
+
+    /**
+        @brief  Try to push a value
+        @tparam U     - value type
+        @param  value - value to push
+        @retval       - true if pushed, false if the queue is full
+    **/
+    template<class U>
+    bool try_push(U&& value);
+
+    /**
+        @brief   Try to occupy a cell and fill it in place
+        @details Useful when T owns memory: the cell value keeps its capacity between uses
+        @tparam  fill_func_t - function type, void(T&)
+        @param   fillFunc    - function filling the cell value, must not throw
+        @retval              - true if the cell was filled, false if the queue is full
+    **/
+    template<class fill_func_t>
+    bool try_push_with(fill_func_t&& fillFunc);
+
+    /**
+        @brief  Try to pop a value
+        @param  value - value to move the front element to
+        @retval       - true if popped, false if the queue is empty
+    **/
+    bool try_pop(T& value);
+
+    /**
+        @brief  Try to process the front element in place and then pop it
+        @tparam consume_func_t - function type, void(T&)
+        @param  consumeFunc    - function processing the front value, must not throw
+        @retval                - true if popped, false if the queue is empty
+    **/
+    template<class consume_func_t>
+    bool try_pop_with(consume_func_t&& consumeFunc);
+
+    /**
+        @brief   Check if the queue is empty
+        @details Takes into account elements which are being pushed right now,
+                 so it may return false while try_pop() still fails for a short time
+        @retval  - true if there are no pushed or being pushed elements
+    **/
+    bool empty() const noexcept;
+
+    /**
+        @brief  Get approximate number of elements
+        @retval  - approximate number of elements
+    **/
+    size_t size() const noexcept;
+
+    /**
+        @brief  Get max number of elements
+        @retval  - max number of elements
+    **/
+    size_t capacity() const noexcept;
+
+private:
+    std::unique_ptr<cell[]> m_pCells;
+    size_t                  m_nMask = 0;
+
+    alignas(details::k_nCacheLineSize) std::atomic<size_t> m_nEnqueuePos = 0;
+    alignas(details::k_nCacheLineSize) std::atomic<size_t> m_nDequeuePos = 0;
+};
+
+QX_POP_SUPPRESS_WARNINGS();
+
+} // namespace qx
+
+#include <qx/containers/mpmc_bounded_queue.inl>
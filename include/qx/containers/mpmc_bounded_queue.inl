@@ -0,0 +1,136 @@
+/**
+
+    @file      mpmc_bounded_queue.inl
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+
+namespace qx
+{
+
+template<class T>
+inline mpmc_bounded_queue<T>::mpmc_bounded_queue(size_t nCapacity)
+{
+    size_t nRoundedCapacity = 2;
+    while (nRoundedCapacity < nCapacity)
+        nRoundedCapacity <<= 1;
+
+    m_pCells = std::make_unique<cell[]>(nRoundedCapacity);
+    m_nMask  = nRoundedCapacity - 1;
+
+    for (size_t i = 0; i < nRoundedCapacity; ++i)
+        m_pCells[i].nSequence.store(i, std::memory_order_relaxed);
+}
+
+template<class T>
+template<class U>
+inline bool mpmc_bounded_queue<T>::try_push(U&& value)
+{
+    return try_push_with(
+        [&value](T& cellValue)
+        {
+            cellValue = std::forward<U>(value);
+        });
+}
+
+template<class T>
+template<class fill_func_t>
+inline bool mpmc_bounded_queue<T>::try_push_with(fill_func_t&& fillFunc)
+{
+    cell*  pCell = nullptr;
+    size_t nPos  = m_nEnqueuePos.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        pCell              = &m_pCells[nPos & m_nMask];
+        const size_t nSeq  = pCell->nSequence.load(std::memory_order_acquire);
+        const auto   nDiff = static_cast<std::ptrdiff_t>(nSeq) - static_cast<std::ptrdiff_t>(nPos);
+
+        if (nDiff == 0)
+        {
+            if (m_nEnqueuePos.compare_exchange_weak(nPos, nPos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (nDiff < 0)
+        {
+            return false;
+        }
+        else
+        {
+            nPos = m_nEnqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    fillFunc(pCell->value);
+    pCell->nSequence.store(nPos + 1, std::memory_order_release);
+
+    return true;
+}
+
+template<class T>
+inline bool mpmc_bounded_queue<T>::try_pop(T& value)
+{
+    return try_pop_with(
+        [&value](T& cellValue)
+        {
+            value = std::move(cellValue);
+        });
+}
+
+template<class T>
+template<class consume_func_t>
+inline bool mpmc_bounded_queue<T>::try_pop_with(consume_func_t&& consumeFunc)
+{
+    cell*  pCell = nullptr;
+    size_t nPos  = m_nDequeuePos.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        pCell              = &m_pCells[nPos & m_nMask];
+        const size_t nSeq  = pCell->nSequence.load(std::memory_order_acquire);
+        const auto   nDiff = static_cast<std::ptrdiff_t>(nSeq) - static_cast<std::ptrdiff_t>(nPos + 1);
+
+        if (nDiff == 0)
+        {
+            if (m_nDequeuePos.compare_exchange_weak(nPos, nPos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (nDiff < 0)
+        {
+            return false;
+        }
+        else
+        {
+            nPos = m_nDequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    consumeFunc(pCell->value);
+    pCell->nSequence.store(nPos + m_nMask + 1, std::memory_order_release);
+
+    return true;
+}
+
+template<class T>
+inline bool mpmc_bounded_queue<T>::empty() const noexcept
+{
+    return size() == 0;
+}
+
+template<class T>
+inline size_t mpmc_bounded_queue<T>::size() const noexcept
+{
+    const size_t nDequeuePos = m_nDequeuePos.load(std::memory_order_acquire);
+    const size_t nEnqueuePos = m_nEnqueuePos.load(std::memory_order_acquire);
+    return nEnqueuePos > nDequeuePos ? nEnqueuePos - nDequeuePos : 0;
+}
+
+template<class T>
+inline size_t mpmc_bounded_queue<T>::capacity() const noexcept
+{
+    return m_nMask + 1;
+}
+
+} // namespace qx
@@ -12,10 +12,12 @@
 #include <qx/containers/string/format_string.h>
 #include <qx/containers/string/string_data.h>
 #include <qx/containers/string/string_hash.h>
+#include <qx/containers/string/string_search.h>
 #include <qx/macros/static_assert.h>
 #include <qx/meta/type_traits.h>
 
 #include <iostream>
+#include <iterator>
 #include <optional>
 #include <string_view>
 #include <vector>
@@ -1285,13 +1285,15 @@ inline typename basic_string<char_t, traits_t>::size_type basic_string<char_t, t
     size_type  nBegin,
     size_type  nEnd) const noexcept
 {
-    return _find(
-        nBegin,
-        nEnd,
-        [chSymbol](const_pointer pCurrentChar)
-        {
-            return *pCurrentChar == chSymbol;
-        });
+    if (nEnd == npos)
+        nEnd = size();
+
+    if (nBegin >= nEnd)
+        return npos;
+
+    const_pointer pData = data();
+    const_pointer pChar = find_char(pData + nBegin, pData + nEnd, chSymbol);
+    return pChar ? static_cast<size_type>(pChar - pData) : npos;
 }
 
 template<class char_t, class traits_t>
@@ -1301,17 +1303,18 @@ inline typename basic_string<char_t, traits_t>::size_type basic_string<char_t, t
     size_type     nWhatSize,
     size_type     nEnd) const noexcept
 {
-    if (pszWhat)
+    nEnd = std::min(nEnd, size());
+
+    if (pszWhat && nBegin < nEnd)
     {
         const size_type nLocalWhatSize = nWhatSize != npos ? nWhatSize : traits_t::length(pszWhat);
 
-        return _find(
-            nBegin,
-            nEnd,
-            [pszWhat, nLocalWhatSize](const_pointer pCurrentChar)
-            {
-                return !traits_t::compare_n(pszWhat, pCurrentChar, nLocalWhatSize);
-            });
+        // the substring must start before nEnd, but may end after it
+        const_pointer   pData      = data();
+        const size_type nSearchEnd = std::min(size(), nEnd + nLocalWhatSize - 1);
+        const_pointer   pFound     = find_substring(pData + nBegin, pData + nSearchEnd, pszWhat, nLocalWhatSize);
+
+        return pFound ? static_cast<size_type>(pFound - pData) : npos;
     }
     else
     {
@@ -1336,6 +1339,12 @@ inline typename basic_string<char_t, traits_t>::size_type basic_string<char_t, t
     size_type nBegin,
     size_type nEnd) const noexcept
 {
+    if constexpr (std::contiguous_iterator<fwd_it_t> && std::is_same_v<std::iter_value_t<fwd_it_t>, value_type>)
+    {
+        if (itWhatBegin != itWhatEnd)
+            return find(std::to_address(itWhatBegin), nBegin, static_cast<size_type>(itWhatEnd - itWhatBegin), nEnd);
+    }
+
     return _find(
         nBegin,
         nEnd,
@@ -1365,13 +1374,14 @@ inline typename basic_string<char_t, traits_t>::size_type basic_string<char_t, t
     size_type  nBegin,
     size_type  nEnd) const noexcept
 {
-    return _rfind(
-        nBegin,
-        nEnd,
-        [chSymbol](const_pointer pCurrentChar)
-        {
-            return *pCurrentChar == chSymbol;
-        });
+    // nBegin is the last position to check
+    const size_type nLast = nBegin < size() ? nBegin + 1 : size();
+    if (nLast <= nEnd)
+        return npos;
+
+    const_pointer pData = data();
+    const_pointer pChar = rfind_char(pData + nEnd, pData + nLast, chSymbol);
+    return pChar ? static_cast<size_type>(pChar - pData) : npos;
 }
 
 template<class char_t, class traits_t>
@@ -1381,17 +1391,19 @@ inline typename basic_string<char_t, traits_t>::size_type basic_string<char_t, t
     size_type     nWhatSize,
     size_type     nEnd) const noexcept
 {
-    if (pszWhat)
+    // nBegin is the last position to check
+    const size_type nLast = nBegin < size() ? nBegin + 1 : size();
+
+    if (pszWhat && nEnd < nLast)
     {
         const size_type nLocalWhatSize = nWhatSize != npos ? nWhatSize : traits_t::length(pszWhat);
 
-        return _rfind(
-            nBegin,
-            nEnd,
-            [pszWhat, nLocalWhatSize](const_pointer pCurrentChar)
-            {
-                return !traits_t::compare_n(pszWhat, pCurrentChar, nLocalWhatSize);
-            });
+        // the substring must start not after nBegin, but may end after it
+        const_pointer   pData      = data();
+        const size_type nSearchEnd = std::min(size(), nLast + nLocalWhatSize - 1);
+        const_pointer   pFound     = rfind_substring(pData + nEnd, pData + nSearchEnd, pszWhat, nLocalWhatSize);
+
+        return pFound ? static_cast<size_type>(pFound - pData) : npos;
     }
     else
     {
@@ -1416,6 +1428,12 @@ inline typename basic_string<char_t, traits_t>::size_type basic_string<char_t, t
     size_type nBegin,
     size_type nEnd) const noexcept
 {
+    if constexpr (std::contiguous_iterator<fwd_it_t> && std::is_same_v<std::iter_value_t<fwd_it_t>, value_type>)
+    {
+        if (itWhatBegin != itWhatEnd)
+            return rfind(std::to_address(itWhatBegin), nBegin, static_cast<size_type>(itWhatEnd - itWhatBegin), nEnd);
+    }
+
     return _rfind(
         nBegin,
         nEnd,
@@ -1453,16 +1471,11 @@ inline typename basic_string<char_t, traits_t>::size_type basic_string<char_t, t
     size_type     nBegin,
     size_type     nWhatSize) const noexcept
 {
-    if (pszWhat)
+    if (pszWhat && nBegin < size())
     {
-        return _find_first_of(
-            pszWhat,
-            pszWhat + nWhatSize,
-            nBegin,
-            [](const_pointer pChar)
-            {
-                return pChar + 1;
-            });
+        const_pointer pData = data();
+        const_pointer pChar = find_first_of_chars(pData + nBegin, pData + size(), pszWhat, nWhatSize);
+        return pChar ? static_cast<size_type>(pChar - pData) : npos;
     }
     else
     {
@@ -1475,21 +1488,7 @@ inline typename basic_string<char_t, traits_t>::size_type basic_string<char_t, t
     const_pointer pszWhat,
     size_type     nBegin) const noexcept
 {
-    if (pszWhat)
-    {
-        return _find_first_of(
-            pszWhat,
-            static_cast<const_pointer>(nullptr),
-            nBegin,
-            [](const_pointer pChar)
-            {
-                return *(pChar + 1) != QX_CHAR_PREFIX(value_type, '\0') ? pChar + 1 : nullptr;
-            });
-    }
-    else
-    {
-        return npos;
-    }
+    return pszWhat ? find_first_of(pszWhat, nBegin, traits_t::length(pszWhat)) : npos;
 }
 
 template<class char_t, class traits_t>
@@ -1540,16 +1539,11 @@ inline typename basic_string<char_t, traits_t>::size_type basic_string<char_t, t
     size_type     nEnd,
     size_type     nWhatSize) const noexcept
 {
-    if (pszWhat)
+    if (pszWhat && nEnd < size())
     {
-        return _find_last_of(
-            pszWhat,
-            pszWhat + nWhatSize,
-            nEnd,
-            [](const_pointer pChar)
-            {
-                return pChar + 1;
-            });
+        const_pointer pData = data();
+        const_pointer pChar = find_last_of_chars(pData + nEnd, pData + size(), pszWhat, nWhatSize);
+        return pChar ? static_cast<size_type>(pChar - pData) : npos;
     }
     else
     {
@@ -1562,21 +1556,7 @@ inline typename basic_string<char_t, traits_t>::size_type basic_string<char_t, t
     const_pointer pszWhat,
     size_type     nEnd) const noexcept
 {
-    if (pszWhat)
-    {
-        return _find_last_of(
-            pszWhat,
-            static_cast<const_pointer>(nullptr),
-            nEnd,
-            [](const_pointer pChar)
-            {
-                return *(pChar + 1) != QX_CHAR_PREFIX(value_type, '\0') ? pChar + 1 : nullptr;
-            });
-    }
-    else
-    {
-        return npos;
-    }
+    return pszWhat ? find_last_of(pszWhat, nEnd, traits_t::length(pszWhat)) : npos;
 }
 
 template<class char_t, class traits_t>
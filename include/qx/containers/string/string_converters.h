@@ -13,6 +13,7 @@
 #include <qx/internal/perf_scope.h>
 
 #include <codecvt>
+#include <cstring>
 #include <locale>
 
 #if QX_WIN
@@ -139,4 +140,89 @@ inline string utf8_to_string(cstring_view pszUtf8)
 #endif
 }
 
+/**
+    @brief  Get max size of a string encoded to UTF-8
+    @tparam char_t  - char type, typically char or wchar_t
+    @param  nLength - string length in chars
+    @retval         - max number of UTF-8 bytes
+**/
+template<class char_t>
+constexpr size_t get_max_utf8_size(size_t nLength) noexcept
+{
+    return sizeof(char_t) == 1 ? nLength : nLength * 4;
+}
+
+/**
+    @brief   Encode a char string to UTF-8 (stub)
+    @details char strings are expected to be UTF-8 already, so they are copied as is
+    @param   stringView - char string view
+    @param   pDest      - output of at least get_max_utf8_size<char>() bytes
+    @retval             - number of written bytes
+**/
+inline size_t encode_utf8(cstring_view stringView, char* pDest) noexcept
+{
+    std::memcpy(pDest, stringView.data(), stringView.size());
+    return stringView.size();
+}
+
+/**
+    @brief   Encode a wchar_t string to UTF-8 without intermediate allocations
+    @details wchar_t is treated as UTF-16 on Windows and as UTF-32 elsewhere,
+             invalid code units are replaced with U+FFFD.
+             Not profiled: it's async signal safe and is used by the flight recorder dump
+    @param   stringView - wchar_t string view
+    @param   pDest      - output of at least get_max_utf8_size<wchar_t>() bytes
+    @retval             - number of written bytes
+**/
+inline size_t encode_utf8(wstring_view stringView, char* pDest) noexcept
+{
+    char* pCurrent = pDest;
+    for (size_t i = 0; i < stringView.size(); ++i)
+    {
+        u32 nCodePoint = static_cast<u32>(stringView[i]);
+
+        if (nCodePoint < 0x80)
+        {
+            *pCurrent++ = static_cast<char>(nCodePoint);
+            continue;
+        }
+
+        if constexpr (sizeof(wchar_t) == 2)
+        {
+            if (nCodePoint >= 0xD800 && nCodePoint <= 0xDBFF && i + 1 < stringView.size())
+            {
+                const u32 nLowSurrogate = static_cast<u32>(stringView[i + 1]);
+                if (nLowSurrogate >= 0xDC00 && nLowSurrogate <= 0xDFFF)
+                {
+                    nCodePoint = 0x10000 + ((nCodePoint - 0xD800) << 10) + (nLowSurrogate - 0xDC00);
+                    ++i;
+                }
+            }
+        }
+
+        if ((nCodePoint >= 0xD800 && nCodePoint <= 0xDFFF) || nCodePoint > 0x10FFFF)
+            nCodePoint = 0xFFFD;
+
+        if (nCodePoint < 0x800)
+        {
+            *pCurrent++ = static_cast<char>(0xC0 | (nCodePoint >> 6));
+        }
+        else if (nCodePoint < 0x10000)
+        {
+            *pCurrent++ = static_cast<char>(0xE0 | (nCodePoint >> 12));
+            *pCurrent++ = static_cast<char>(0x80 | ((nCodePoint >> 6) & 0x3F));
+        }
+        else
+        {
+            *pCurrent++ = static_cast<char>(0xF0 | (nCodePoint >> 18));
+            *pCurrent++ = static_cast<char>(0x80 | ((nCodePoint >> 12) & 0x3F));
+            *pCurrent++ = static_cast<char>(0x80 | ((nCodePoint >> 6) & 0x3F));
+        }
+
+        *pCurrent++ = static_cast<char>(0x80 | (nCodePoint & 0x3F));
+    }
+
+    return static_cast<size_t>(pCurrent - pDest);
+}
+
 } // namespace qx
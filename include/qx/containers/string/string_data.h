@@ -9,11 +9,49 @@
 #pragma once
 
 #include <array>
+#include <cstdlib> // std::realloc
 #include <cstring> // std::memmove
 
+#ifdef QX_CONF_USE_ALLOCATION_TRACKER
+    #include <qx/profiler/allocation_tracker.h>
+#endif
+
 namespace qx
 {
 
+namespace details
+{
+
+/**
+    @brief  Reallocate string memory
+    @param  pBlock - memory block, may be nullptr
+    @param  nBytes - new number of bytes
+    @retval        - reallocated memory or nullptr
+**/
+inline void* string_realloc(void* pBlock, size_t nBytes) noexcept
+{
+#ifdef QX_CONF_USE_ALLOCATION_TRACKER
+    return allocation_tracker::reallocate(pBlock, nBytes);
+#else
+    return std::realloc(pBlock, nBytes);
+#endif
+}
+
+/**
+    @brief Free string memory
+    @param pBlock - memory block, may be nullptr
+**/
+inline void string_free(void* pBlock) noexcept
+{
+#ifdef QX_CONF_USE_ALLOCATION_TRACKER
+    allocation_tracker::deallocate(pBlock);
+#else
+    std::free(pBlock);
+#endif
+}
+
+} // namespace details
+
 enum class string_resize_type
 {
     common,
@@ -29,7 +29,7 @@ void string_data<traits_t>::free() noexcept
 {
     if (!is_small())
     {
-        std::free(m_pData);
+        details::string_free(m_pData);
         m_pData = nullptr;
     }
 
@@ -75,7 +75,7 @@ bool string_data<traits_t>::resize(size_type nSymbols, size_type nAlign, string_
                 nStartSize = size() * sizeof(value_type);
             }
 
-            if (void* pNewBlock = std::realloc(bSmallAtStart ? nullptr : m_pData, nNewSize))
+            if (void* pNewBlock = details::string_realloc(bSmallAtStart ? nullptr : m_pData, nNewSize))
             {
                 m_nAllocatedSize = nSymbolsToAllocate;
                 m_pData          = static_cast<typename traits_t::value_type*>(pNewBlock);
@@ -0,0 +1,146 @@
+/**
+
+    @file      string_search.h
+    @brief     Character and substring search kernels for strings
+    @details   SSE2 and AVX2 versions are chosen at compile time by the target instruction set,
+               define QX_CONF_STRING_DISABLE_SIMD to use the scalar versions only.
+               Scalar versions are also used in constant evaluation and for unsupported char types
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+#pragma once
+
+#include <qx/macros/config.h>
+#include <qx/typedefs.h>
+
+#include <bit>
+#include <cstring>
+#include <type_traits>
+
+#if !defined(QX_CONF_STRING_DISABLE_SIMD) && defined(__AVX2__)
+    #define _QX_STRING_AVX2 1
+#else
+    #define _QX_STRING_AVX2 0
+#endif
+
+#if !defined(QX_CONF_STRING_DISABLE_SIMD)                                                                   \
+    && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define _QX_STRING_SSE2 1
+#else
+    #define _QX_STRING_SSE2 0
+#endif
+
+#if _QX_STRING_AVX2
+    #include <immintrin.h>
+#elif _QX_STRING_SSE2
+    #include <emmintrin.h>
+#endif
+
+namespace qx
+{
+
+//! Max number of chars in a set which is searched with SIMD instructions in find_first_of_chars and find_last_of_chars
+constexpr size_t k_nStringSimdCharSetSize = 16;
+
+//! Min needle size which is searched with Boyer-Moore-Horspool algorithm in find_substring and rfind_substring
+constexpr size_t k_nStringLongNeedleSize = 64;
+
+//! Min range size which is searched with Boyer-Moore-Horspool algorithm, shorter ranges don't pay for the shift table
+constexpr size_t k_nStringLongHaystackSize = 1024;
+
+/**
+    @brief  Find the first occurrence of a char
+    @tparam char_t - char type
+    @param  pBegin - range begin
+    @param  pEnd   - range end
+    @param  chWhat - char to search for
+    @retval        - pointer to the found char or nullptr
+**/
+template<class char_t>
+constexpr const char_t* find_char(const char_t* pBegin, const char_t* pEnd, char_t chWhat) noexcept;
+
+/**
+    @brief  Find the last occurrence of a char
+    @tparam char_t - char type
+    @param  pBegin - range begin
+    @param  pEnd   - range end
+    @param  chWhat - char to search for
+    @retval        - pointer to the found char or nullptr
+**/
+template<class char_t>
+constexpr const char_t* rfind_char(const char_t* pBegin, const char_t* pEnd, char_t chWhat) noexcept;
+
+/**
+    @brief  Find the first char which is equal to one of the set chars
+    @tparam char_t   - char type
+    @param  pBegin   - range begin
+    @param  pEnd     - range end
+    @param  pSet     - chars to search for
+    @param  nSetSize - number of chars to search for, sets up to k_nStringSimdCharSetSize are vectorized
+    @retval          - pointer to the found char or nullptr
+**/
+template<class char_t>
+constexpr const char_t* find_first_of_chars(
+    const char_t* pBegin,
+    const char_t* pEnd,
+    const char_t* pSet,
+    size_t        nSetSize) noexcept;
+
+/**
+    @brief  Find the last char which is equal to one of the set chars
+    @tparam char_t   - char type
+    @param  pBegin   - range begin
+    @param  pEnd     - range end
+    @param  pSet     - chars to search for
+    @param  nSetSize - number of chars to search for, sets up to k_nStringSimdCharSetSize are vectorized
+    @retval          - pointer to the found char or nullptr
+**/
+template<class char_t>
+constexpr const char_t* find_last_of_chars(
+    const char_t* pBegin,
+    const char_t* pEnd,
+    const char_t* pSet,
+    size_t        nSetSize) noexcept;
+
+/**
+    @brief   Find the first occurrence of a substring
+    @details Short needles are searched by the first and the last chars with SIMD instructions
+             and checked in full only where both match,
+             needles from k_nStringLongNeedleSize chars in ranges from k_nStringLongHaystackSize chars
+             are searched with Boyer-Moore-Horspool algorithm
+    @tparam  char_t    - char type
+    @param   pBegin    - range begin
+    @param   pEnd      - range end, the substring must fit into the range
+    @param   pWhat     - substring to search for
+    @param   nWhatSize - substring size
+    @retval            - pointer to the found substring or nullptr, pBegin for an empty substring
+**/
+template<class char_t>
+constexpr const char_t* find_substring(
+    const char_t* pBegin,
+    const char_t* pEnd,
+    const char_t* pWhat,
+    size_t        nWhatSize) noexcept;
+
+/**
+    @brief   Find the last occurrence of a substring
+    @details Algorithms are the same as in find_substring
+    @tparam  char_t    - char type
+    @param   pBegin    - range begin
+    @param   pEnd      - range end, the substring must fit into the range
+    @param   pWhat     - substring to search for
+    @param   nWhatSize - substring size
+    @retval            - pointer to the found substring or nullptr, pEnd for an empty substring
+**/
+template<class char_t>
+constexpr const char_t* rfind_substring(
+    const char_t* pBegin,
+    const char_t* pEnd,
+    const char_t* pWhat,
+    size_t        nWhatSize) noexcept;
+
+} // namespace qx
+
+#include <qx/containers/string/string_search.inl>
@@ -0,0 +1,708 @@
+/**
+
+    @file      string_search.inl
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+
+namespace qx::details
+{
+
+template<class char_t>
+constexpr bool is_simd_char_v =
+    std::is_integral_v<char_t> && (sizeof(char_t) == 1 || sizeof(char_t) == 2 || sizeof(char_t) == 4);
+
+template<class char_t>
+constexpr bool is_one_of_chars(char_t ch, const char_t* pSet, size_t nSetSize) noexcept
+{
+    for (size_t i = 0; i < nSetSize; ++i)
+        if (pSet[i] == ch)
+            return true;
+
+    return false;
+}
+
+template<class char_t>
+constexpr bool equal_chars(const char_t* pLeft, const char_t* pRight, size_t nSize) noexcept
+{
+    if constexpr (std::is_integral_v<char_t>)
+    {
+        if (!std::is_constant_evaluated())
+            return std::memcmp(pLeft, pRight, nSize * sizeof(char_t)) == 0;
+    }
+
+    for (size_t i = 0; i < nSize; ++i)
+        if (pLeft[i] != pRight[i])
+            return false;
+
+    return true;
+}
+
+template<class char_t>
+constexpr const char_t* find_char_scalar(const char_t* pBegin, const char_t* pEnd, char_t chWhat) noexcept
+{
+    for (const char_t* pChar = pBegin; pChar < pEnd; ++pChar)
+        if (*pChar == chWhat)
+            return pChar;
+
+    return nullptr;
+}
+
+template<class char_t>
+constexpr const char_t* rfind_char_scalar(const char_t* pBegin, const char_t* pEnd, char_t chWhat) noexcept
+{
+    for (const char_t* pChar = pEnd; pChar > pBegin;)
+        if (*--pChar == chWhat)
+            return pChar;
+
+    return nullptr;
+}
+
+template<class char_t>
+constexpr const char_t* find_first_of_chars_scalar(
+    const char_t* pBegin,
+    const char_t* pEnd,
+    const char_t* pSet,
+    size_t        nSetSize) noexcept
+{
+    for (const char_t* pChar = pBegin; pChar < pEnd; ++pChar)
+        if (is_one_of_chars(*pChar, pSet, nSetSize))
+            return pChar;
+
+    return nullptr;
+}
+
+template<class char_t>
+constexpr const char_t* find_last_of_chars_scalar(
+    const char_t* pBegin,
+    const char_t* pEnd,
+    const char_t* pSet,
+    size_t        nSetSize) noexcept
+{
+    for (const char_t* pChar = pEnd; pChar > pBegin;)
+        if (is_one_of_chars(*--pChar, pSet, nSetSize))
+            return pChar;
+
+    return nullptr;
+}
+
+// pEnd - pBegin >= nWhatSize >= 2 for all substring search algorithms below
+
+template<class char_t>
+constexpr const char_t* find_substring_scalar(
+    const char_t* pBegin,
+    const char_t* pEnd,
+    const char_t* pWhat,
+    size_t        nWhatSize) noexcept
+{
+    for (const char_t* pChar = pBegin; static_cast<size_t>(pEnd - pChar) >= nWhatSize; ++pChar)
+        if (*pChar == *pWhat && equal_chars(pChar + 1, pWhat + 1, nWhatSize - 1))
+            return pChar;
+
+    return nullptr;
+}
+
+template<class char_t>
+constexpr const char_t* rfind_substring_scalar(
+    const char_t* pBegin,
+    const char_t* pEnd,
+    const char_t* pWhat,
+    size_t        nWhatSize) noexcept
+{
+    for (const char_t* pChar = pEnd - nWhatSize + 1; pChar > pBegin;)
+    {
+        --pChar;
+        if (*pChar == *pWhat && equal_chars(pChar + 1, pWhat + 1, nWhatSize - 1))
+            return pChar;
+    }
+
+    return nullptr;
+}
+
+// wide chars share shifts by their low byte, which keeps the table small and the shifts safe
+constexpr size_t k_nHorspoolTableSize = 256;
+
+template<class char_t>
+constexpr size_t horspool_index(char_t ch) noexcept
+{
+    return static_cast<size_t>(static_cast<std::make_unsigned_t<char_t>>(ch)) % k_nHorspoolTableSize;
+}
+
+template<class char_t>
+constexpr const char_t* find_substring_horspool(
+    const char_t* pBegin,
+    const char_t* pEnd,
+    const char_t* pWhat,
+    size_t        nWhatSize) noexcept
+{
+    // shift by the distance from the last occurrence of the window's last char to the needle end
+    size_t shifts[k_nHorspoolTableSize];
+    for (size_t& nShift : shifts)
+        nShift = nWhatSize;
+
+    for (size_t i = 0; i + 1 < nWhatSize; ++i)
+        shifts[horspool_index(pWhat[i])] = nWhatSize - 1 - i;
+
+    const char_t chLast = pWhat[nWhatSize - 1];
+
+    for (const char_t* pWindow = pBegin; static_cast<size_t>(pEnd - pWindow) >= nWhatSize;)
+    {
+        const char_t chWindowLast = pWindow[nWhatSize - 1];
+        if (chWindowLast == chLast && equal_chars(pWindow, pWhat, nWhatSize - 1))
+            return pWindow;
+
+        pWindow += shifts[horspool_index(chWindowLast)];
+    }
+
+    return nullptr;
+}
+
+template<class char_t>
+constexpr const char_t* rfind_substring_horspool(
+    const char_t* pBegin,
+    const char_t* pEnd,
+    const char_t* pWhat,
+    size_t        nWhatSize) noexcept
+{
+    // mirrored: shift by the distance from the needle begin to the first occurrence of the window's first char
+    size_t shifts[k_nHorspoolTableSize];
+    for (size_t& nShift : shifts)
+        nShift = nWhatSize;
+
+    for (size_t i = nWhatSize - 1; i > 0; --i)
+        shifts[horspool_index(pWhat[i])] = i;
+
+    const char_t chFirst = pWhat[0];
+
+    for (const char_t* pWindow = pEnd - nWhatSize;;)
+    {
+        const char_t chWindowFirst = *pWindow;
+        if (chWindowFirst == chFirst && equal_chars(pWindow + 1, pWhat + 1, nWhatSize - 1))
+            return pWindow;
+
+        const size_t nShift = shifts[horspool_index(chWindowFirst)];
+        if (static_cast<size_t>(pWindow - pBegin) < nShift)
+            return nullptr;
+
+        pWindow -= nShift;
+    }
+}
+
+#if _QX_STRING_SSE2
+
+struct string_simd_sse2
+{
+    using vector = __m128i;
+
+    // there is no narrower vector, the rest of a range is processed by the scalar version
+    using narrower = void;
+
+    static vector load(const void* pData) noexcept
+    {
+        return _mm_loadu_si128(static_cast<const vector*>(pData));
+    }
+
+    template<class char_t>
+    static vector broadcast(char_t ch) noexcept
+    {
+        if constexpr (sizeof(char_t) == 1)
+            return _mm_set1_epi8(static_cast<char>(ch));
+        else if constexpr (sizeof(char_t) == 2)
+            return _mm_set1_epi16(static_cast<short>(ch));
+        else
+            return _mm_set1_epi32(static_cast<int>(ch));
+    }
+
+    template<class char_t>
+    static vector equal(vector left, vector right) noexcept
+    {
+        if constexpr (sizeof(char_t) == 1)
+            return _mm_cmpeq_epi8(left, right);
+        else if constexpr (sizeof(char_t) == 2)
+            return _mm_cmpeq_epi16(left, right);
+        else
+            return _mm_cmpeq_epi32(left, right);
+    }
+
+    static vector bit_or(vector left, vector right) noexcept
+    {
+        return _mm_or_si128(left, right);
+    }
+
+    static vector bit_and(vector left, vector right) noexcept
+    {
+        return _mm_and_si128(left, right);
+    }
+
+    static u32 mask(vector value) noexcept
+    {
+        return static_cast<u32>(_mm_movemask_epi8(value));
+    }
+};
+
+#endif
+
+#if _QX_STRING_AVX2
+
+struct string_simd_avx2
+{
+    using vector   = __m256i;
+    using narrower = string_simd_sse2;
+
+    static vector load(const void* pData) noexcept
+    {
+        return _mm256_loadu_si256(static_cast<const vector*>(pData));
+    }
+
+    template<class char_t>
+    static vector broadcast(char_t ch) noexcept
+    {
+        if constexpr (sizeof(char_t) == 1)
+            return _mm256_set1_epi8(static_cast<char>(ch));
+        else if constexpr (sizeof(char_t) == 2)
+            return _mm256_set1_epi16(static_cast<short>(ch));
+        else
+            return _mm256_set1_epi32(static_cast<int>(ch));
+    }
+
+    template<class char_t>
+    static vector equal(vector left, vector right) noexcept
+    {
+        if constexpr (sizeof(char_t) == 1)
+            return _mm256_cmpeq_epi8(left, right);
+        else if constexpr (sizeof(char_t) == 2)
+            return _mm256_cmpeq_epi16(left, right);
+        else
+            return _mm256_cmpeq_epi32(left, right);
+    }
+
+    static vector bit_or(vector left, vector right) noexcept
+    {
+        return _mm256_or_si256(left, right);
+    }
+
+    static vector bit_and(vector left, vector right) noexcept
+    {
+        return _mm256_and_si256(left, right);
+    }
+
+    static u32 mask(vector value) noexcept
+    {
+        return static_cast<u32>(_mm256_movemask_epi8(value));
+    }
+};
+
+using string_simd = string_simd_avx2;
+
+#elif _QX_STRING_SSE2
+
+using string_simd = string_simd_sse2;
+
+#endif
+
+#if _QX_STRING_SSE2
+
+// a mask has sizeof(char_t) bits per char
+template<class char_t>
+inline size_t first_char_in_mask(u32 nMask) noexcept
+{
+    return static_cast<size_t>(std::countr_zero(nMask)) / sizeof(char_t);
+}
+
+template<class char_t>
+inline size_t last_char_in_mask(u32 nMask) noexcept
+{
+    return static_cast<size_t>(std::bit_width(nMask) - 1) / sizeof(char_t);
+}
+
+// number of vectors checked in one iteration of the single char search
+constexpr size_t k_nUnroll = 4;
+
+template<class simd_t, class char_t>
+inline bool unrolled_match(const char_t* pBlocks, typename simd_t::vector what) noexcept
+{
+    constexpr size_t k_nChars = sizeof(typename simd_t::vector) / sizeof(char_t);
+
+    const typename simd_t::vector found01 = simd_t::bit_or(
+        simd_t::template equal<char_t>(simd_t::load(pBlocks), what),
+        simd_t::template equal<char_t>(simd_t::load(pBlocks + k_nChars), what));
+    const typename simd_t::vector found23 = simd_t::bit_or(
+        simd_t::template equal<char_t>(simd_t::load(pBlocks + 2 * k_nChars), what),
+        simd_t::template equal<char_t>(simd_t::load(pBlocks + 3 * k_nChars), what));
+
+    static_assert(k_nUnroll == 4);
+    return simd_t::mask(simd_t::bit_or(found01, found23)) != 0;
+}
+
+template<class simd_t, class char_t>
+inline const char_t* find_char_simd(const char_t* pBegin, const char_t* pEnd, char_t chWhat) noexcept
+{
+    constexpr size_t k_nChars = sizeof(typename simd_t::vector) / sizeof(char_t);
+
+    const typename simd_t::vector what = simd_t::broadcast(chWhat);
+
+    const char_t* pChar = pBegin;
+
+    // check several vectors at once and find the exact one only when there is a match
+    for (; static_cast<size_t>(pEnd - pChar) >= k_nUnroll * k_nChars; pChar += k_nUnroll * k_nChars)
+    {
+        if (!unrolled_match<simd_t>(pChar, what))
+            continue;
+
+        for (size_t i = 0; i < k_nUnroll; ++i, pChar += k_nChars)
+        {
+            if (const u32 nMask = simd_t::mask(simd_t::template equal<char_t>(simd_t::load(pChar), what)))
+                return pChar + first_char_in_mask<char_t>(nMask);
+        }
+    }
+
+    for (; static_cast<size_t>(pEnd - pChar) >= k_nChars; pChar += k_nChars)
+    {
+        if (const u32 nMask = simd_t::mask(simd_t::template equal<char_t>(simd_t::load(pChar), what)))
+            return pChar + first_char_in_mask<char_t>(nMask);
+    }
+
+    if constexpr (std::is_void_v<typename simd_t::narrower>)
+        return find_char_scalar(pChar, pEnd, chWhat);
+    else
+        return find_char_simd<typename simd_t::narrower>(pChar, pEnd, chWhat);
+}
+
+template<class simd_t, class char_t>
+inline const char_t* rfind_char_simd(const char_t* pBegin, const char_t* pEnd, char_t chWhat) noexcept
+{
+    constexpr size_t k_nChars = sizeof(typename simd_t::vector) / sizeof(char_t);
+
+    const typename simd_t::vector what = simd_t::broadcast(chWhat);
+
+    const char_t* pBlockEnd = pEnd;
+
+    // check several vectors at once and find the exact one only when there is a match
+    for (; static_cast<size_t>(pBlockEnd - pBegin) >= k_nUnroll * k_nChars; pBlockEnd -= k_nUnroll * k_nChars)
+    {
+        if (!unrolled_match<simd_t>(pBlockEnd - k_nUnroll * k_nChars, what))
+            continue;
+
+        for (size_t i = 0; i < k_nUnroll; ++i, pBlockEnd -= k_nChars)
+        {
+            const char_t* pBlock = pBlockEnd - k_nChars;
+            if (const u32 nMask = simd_t::mask(simd_t::template equal<char_t>(simd_t::load(pBlock), what)))
+                return pBlock + last_char_in_mask<char_t>(nMask);
+        }
+    }
+
+    for (; static_cast<size_t>(pBlockEnd - pBegin) >= k_nChars; pBlockEnd -= k_nChars)
+    {
+        const char_t* pBlock = pBlockEnd - k_nChars;
+        if (const u32 nMask = simd_t::mask(simd_t::template equal<char_t>(simd_t::load(pBlock), what)))
+            return pBlock + last_char_in_mask<char_t>(nMask);
+    }
+
+    if constexpr (std::is_void_v<typename simd_t::narrower>)
+        return rfind_char_scalar(pBegin, pBlockEnd, chWhat);
+    else
+        return rfind_char_simd<typename simd_t::narrower>(pBegin, pBlockEnd, chWhat);
+}
+
+template<class simd_t, class char_t>
+inline u32 find_chars_mask(const typename simd_t::vector* pSet, size_t nSetSize, const char_t* pBlock) noexcept
+{
+    const typename simd_t::vector block = simd_t::load(pBlock);
+
+    typename simd_t::vector found = simd_t::template equal<char_t>(block, pSet[0]);
+    for (size_t i = 1; i < nSetSize; ++i)
+        found = simd_t::bit_or(found, simd_t::template equal<char_t>(block, pSet[i]));
+
+    return simd_t::mask(found);
+}
+
+template<class simd_t, class char_t>
+inline const char_t* find_first_of_chars_simd(
+    const char_t* pBegin,
+    const char_t* pEnd,
+    const char_t* pSet,
+    size_t        nSetSize) noexcept
+{
+    constexpr size_t k_nChars = sizeof(typename simd_t::vector) / sizeof(char_t);
+
+    typename simd_t::vector set[k_nStringSimdCharSetSize];
+    for (size_t i = 0; i < nSetSize; ++i)
+        set[i] = simd_t::broadcast(pSet[i]);
+
+    const char_t* pChar = pBegin;
+    for (; static_cast<size_t>(pEnd - pChar) >= k_nChars; pChar += k_nChars)
+    {
+        if (const u32 nMask = find_chars_mask<simd_t>(set, nSetSize, pChar))
+            return pChar + first_char_in_mask<char_t>(nMask);
+    }
+
+    if constexpr (std::is_void_v<typename simd_t::narrower>)
+        return find_first_of_chars_scalar(pChar, pEnd, pSet, nSetSize);
+    else
+        return find_first_of_chars_simd<typename simd_t::narrower>(pChar, pEnd, pSet, nSetSize);
+}
+
+template<class simd_t, class char_t>
+inline const char_t* find_last_of_chars_simd(
+    const char_t* pBegin,
+    const char_t* pEnd,
+    const char_t* pSet,
+    size_t        nSetSize) noexcept
+{
+    constexpr size_t k_nChars = sizeof(typename simd_t::vector) / sizeof(char_t);
+
+    typename simd_t::vector set[k_nStringSimdCharSetSize];
+    for (size_t i = 0; i < nSetSize; ++i)
+        set[i] = simd_t::broadcast(pSet[i]);
+
+    const char_t* pBlockEnd = pEnd;
+    for (; static_cast<size_t>(pBlockEnd - pBegin) >= k_nChars; pBlockEnd -= k_nChars)
+    {
+        const char_t* pBlock = pBlockEnd - k_nChars;
+        if (const u32 nMask = find_chars_mask<simd_t>(set, nSetSize, pBlock))
+            return pBlock + last_char_in_mask<char_t>(nMask);
+    }
+
+    if constexpr (std::is_void_v<typename simd_t::narrower>)
+        return find_last_of_chars_scalar(pBegin, pBlockEnd, pSet, nSetSize);
+    else
+        return find_last_of_chars_simd<typename simd_t::narrower>(pBegin, pBlockEnd, pSet, nSetSize);
+}
+
+// a mask has sizeof(char_t) bits per char, remove all bits of the char at nBit
+template<class char_t>
+inline u32 clear_char_in_mask(u32 nMask, size_t nBit) noexcept
+{
+    constexpr u32 k_nCharBits = (1u << sizeof(char_t)) - 1;
+    return nMask & ~(k_nCharBits << (nBit / sizeof(char_t) * sizeof(char_t)));
+}
+
+template<class simd_t, class char_t>
+inline u32 first_and_last_chars_mask(
+    const char_t*           pBlock,
+    size_t                  nWhatSize,
+    typename simd_t::vector first,
+    typename simd_t::vector last) noexcept
+{
+    return simd_t::mask(simd_t::bit_and(
+        simd_t::template equal<char_t>(simd_t::load(pBlock), first),
+        simd_t::template equal<char_t>(simd_t::load(pBlock + nWhatSize - 1), last)));
+}
+
+template<class simd_t, class char_t>
+inline const char_t* find_substring_simd(
+    const char_t* pBegin,
+    const char_t* pEnd,
+    const char_t* pWhat,
+    size_t        nWhatSize) noexcept
+{
+    constexpr size_t k_nChars = sizeof(typename simd_t::vector) / sizeof(char_t);
+
+    const typename simd_t::vector first = simd_t::broadcast(pWhat[0]);
+    const typename simd_t::vector last  = simd_t::broadcast(pWhat[nWhatSize - 1]);
+
+    // the block checks k_nChars positions, so its last char load ends at pBlock + nWhatSize - 1 + k_nChars
+    const char_t* pBlock = pBegin;
+    for (; static_cast<size_t>(pEnd - pBlock) >= nWhatSize - 1 + k_nChars; pBlock += k_nChars)
+    {
+        u32 nMask = first_and_last_chars_mask<simd_t>(pBlock, nWhatSize, first, last);
+        while (nMask)
+        {
+            const size_t  nBit       = static_cast<size_t>(std::countr_zero(nMask));
+            const char_t* pCandidate = pBlock + nBit / sizeof(char_t);
+            if (equal_chars(pCandidate + 1, pWhat + 1, nWhatSize - 2))
+                return pCandidate;
+
+            nMask = clear_char_in_mask<char_t>(nMask, nBit);
+        }
+    }
+
+    if (static_cast<size_t>(pEnd - pBlock) < nWhatSize)
+        return nullptr;
+    else if constexpr (std::is_void_v<typename simd_t::narrower>)
+        return find_substring_scalar(pBlock, pEnd, pWhat, nWhatSize);
+    else
+        return find_substring_simd<typename simd_t::narrower>(pBlock, pEnd, pWhat, nWhatSize);
+}
+
+template<class simd_t, class char_t>
+inline const char_t* rfind_substring_simd(
+    const char_t* pBegin,
+    const char_t* pEnd,
+    const char_t* pWhat,
+    size_t        nWhatSize) noexcept
+{
+    constexpr size_t k_nChars = sizeof(typename simd_t::vector) / sizeof(char_t);
+
+    const typename simd_t::vector first = simd_t::broadcast(pWhat[0]);
+    const typename simd_t::vector last  = simd_t::broadcast(pWhat[nWhatSize - 1]);
+
+    // positions after pBlockEnd are checked, so substrings in [pBegin, pBlockEnd + nWhatSize - 1) are left
+    const char_t* pBlockEnd = pEnd - nWhatSize + 1;
+    for (; static_cast<size_t>(pBlockEnd - pBegin) >= k_nChars; pBlockEnd -= k_nChars)
+    {
+        const char_t* pBlock = pBlockEnd - k_nChars;
+
+        u32 nMask = first_and_last_chars_mask<simd_t>(pBlock, nWhatSize, first, last);
+        while (nMask)
+        {
+            const size_t  nBit       = static_cast<size_t>(std::bit_width(nMask) - 1);
+            const char_t* pCandidate = pBlock + nBit / sizeof(char_t);
+            if (equal_chars(pCandidate + 1, pWhat + 1, nWhatSize - 2))
+                return pCandidate;
+
+            nMask = clear_char_in_mask<char_t>(nMask, nBit);
+        }
+    }
+
+    const char_t* pRestEnd = pBlockEnd + nWhatSize - 1;
+    if (static_cast<size_t>(pRestEnd - pBegin) < nWhatSize)
+        return nullptr;
+    else if constexpr (std::is_void_v<typename simd_t::narrower>)
+        return rfind_substring_scalar(pBegin, pRestEnd, pWhat, nWhatSize);
+    else
+        return rfind_substring_simd<typename simd_t::narrower>(pBegin, pRestEnd, pWhat, nWhatSize);
+}
+
+#endif
+
+} // namespace qx::details
+
+namespace qx
+{
+
+template<class char_t>
+constexpr const char_t* find_char(const char_t* pBegin, const char_t* pEnd, char_t chWhat) noexcept
+{
+#if _QX_STRING_SSE2
+    if constexpr (details::is_simd_char_v<char_t>)
+    {
+        if (!std::is_constant_evaluated())
+            return details::find_char_simd<details::string_simd>(pBegin, pEnd, chWhat);
+    }
+#endif
+
+    return details::find_char_scalar(pBegin, pEnd, chWhat);
+}
+
+template<class char_t>
+constexpr const char_t* rfind_char(const char_t* pBegin, const char_t* pEnd, char_t chWhat) noexcept
+{
+#if _QX_STRING_SSE2
+    if constexpr (details::is_simd_char_v<char_t>)
+    {
+        if (!std::is_constant_evaluated())
+            return details::rfind_char_simd<details::string_simd>(pBegin, pEnd, chWhat);
+    }
+#endif
+
+    return details::rfind_char_scalar(pBegin, pEnd, chWhat);
+}
+
+template<class char_t>
+constexpr const char_t* find_first_of_chars(
+    const char_t* pBegin,
+    const char_t* pEnd,
+    const char_t* pSet,
+    size_t        nSetSize) noexcept
+{
+    if (nSetSize == 1)
+        return find_char(pBegin, pEnd, pSet[0]);
+
+#if _QX_STRING_SSE2
+    if constexpr (details::is_simd_char_v<char_t>)
+    {
+        if (!std::is_constant_evaluated() && nSetSize > 1 && nSetSize <= k_nStringSimdCharSetSize)
+            return details::find_first_of_chars_simd<details::string_simd>(pBegin, pEnd, pSet, nSetSize);
+    }
+#endif
+
+    return details::find_first_of_chars_scalar(pBegin, pEnd, pSet, nSetSize);
+}
+
+template<class char_t>
+constexpr const char_t* find_last_of_chars(
+    const char_t* pBegin,
+    const char_t* pEnd,
+    const char_t* pSet,
+    size_t        nSetSize) noexcept
+{
+    if (nSetSize == 1)
+        return rfind_char(pBegin, pEnd, pSet[0]);
+
+#if _QX_STRING_SSE2
+    if constexpr (details::is_simd_char_v<char_t>)
+    {
+        if (!std::is_constant_evaluated() && nSetSize > 1 && nSetSize <= k_nStringSimdCharSetSize)
+            return details::find_last_of_chars_simd<details::string_simd>(pBegin, pEnd, pSet, nSetSize);
+    }
+#endif
+
+    return details::find_last_of_chars_scalar(pBegin, pEnd, pSet, nSetSize);
+}
+
+template<class char_t>
+constexpr const char_t* find_substring(
+    const char_t* pBegin,
+    const char_t* pEnd,
+    const char_t* pWhat,
+    size_t        nWhatSize) noexcept
+{
+    if (nWhatSize == 0)
+        return pBegin;
+    else if (static_cast<size_t>(pEnd - pBegin) < nWhatSize)
+        return nullptr;
+    else if (nWhatSize == 1)
+        return find_char(pBegin, pEnd, *pWhat);
+
+    if constexpr (std::is_integral_v<char_t>)
+    {
+        if (nWhatSize >= k_nStringLongNeedleSize && static_cast<size_t>(pEnd - pBegin) >= k_nStringLongHaystackSize)
+            return details::find_substring_horspool(pBegin, pEnd, pWhat, nWhatSize);
+    }
+
+#if _QX_STRING_SSE2
+    if constexpr (details::is_simd_char_v<char_t>)
+    {
+        if (!std::is_constant_evaluated())
+            return details::find_substring_simd<details::string_simd>(pBegin, pEnd, pWhat, nWhatSize);
+    }
+#endif
+
+    return details::find_substring_scalar(pBegin, pEnd, pWhat, nWhatSize);
+}
+
+template<class char_t>
+constexpr const char_t* rfind_substring(
+    const char_t* pBegin,
+    const char_t* pEnd,
+    const char_t* pWhat,
+    size_t        nWhatSize) noexcept
+{
+    if (nWhatSize == 0)
+        return pEnd;
+    else if (static_cast<size_t>(pEnd - pBegin) < nWhatSize)
+        return nullptr;
+    else if (nWhatSize == 1)
+        return rfind_char(pBegin, pEnd, *pWhat);
+
+    if constexpr (std::is_integral_v<char_t>)
+    {
+        if (nWhatSize >= k_nStringLongNeedleSize && static_cast<size_t>(pEnd - pBegin) >= k_nStringLongHaystackSize)
+            return details::rfind_substring_horspool(pBegin, pEnd, pWhat, nWhatSize);
+    }
+
+#if _QX_STRING_SSE2
+    if constexpr (details::is_simd_char_v<char_t>)
+    {
+        if (!std::is_constant_evaluated())
+            return details::rfind_substring_simd<details::string_simd>(pBegin, pEnd, pWhat, nWhatSize);
+    }
+#endif
+
+    return details::rfind_substring_scalar(pBegin, pEnd, pWhat, nWhatSize);
+}
+
+} // namespace qx
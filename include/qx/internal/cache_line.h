@@ -0,0 +1,24 @@
+/**
+
+    @file      cache_line.h
+    @brief     Contains cache line size constant (for internal usage only)
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+#pragma once
+
+#include <cstddef>
+
+namespace qx::details
+{
+
+/**
+    @brief   Cache line size for separating data written by different threads
+    @details std::hardware_destructive_interference_size is not used
+             because its value may differ between translation units and compilers warn about it
+**/
+constexpr std::size_t k_nCacheLineSize = 64;
+
+} // namespace qx::details
@@ -0,0 +1,57 @@
+/**
+
+    @file      json.h
+    @brief     Contains JSON writing helpers for exporters (for internal usage only)
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+#pragma once
+
+#include <format>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+namespace qx::details
+{
+
+/**
+    @brief Append a string to JSON as a string value content
+    @param sJson - JSON string
+    @param svStr - UTF-8 string
+**/
+inline void append_json_escaped(std::string& sJson, std::string_view svStr)
+{
+    for (const char ch : svStr)
+    {
+        switch (ch)
+        {
+        case '"':
+            sJson += "\\\"";
+            break;
+
+        case '\\':
+            sJson += "\\\\";
+            break;
+
+        case '\n':
+            sJson += "\\n";
+            break;
+
+        case '\t':
+            sJson += "\\t";
+            break;
+
+        default:
+            if (static_cast<unsigned char>(ch) < 0x20)
+                std::format_to(std::back_inserter(sJson), "\\u{:04x}", static_cast<unsigned>(ch));
+            else
+                sJson += ch;
+            break;
+        }
+    }
+}
+
+} // namespace qx::details
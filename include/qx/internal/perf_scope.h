@@ -11,26 +11,54 @@
 
 #include <qx/macros/common.h>
 
+#ifdef QX_CONF_USE_PROFILER
+    #include <qx/profiler/profiler.h>
+#endif
+
+#ifdef QX_CONF_USE_PERF_MUTEX
+    #include <qx/profiler/perf_mutex.h>
+#endif
+
 #ifndef QX_PERF_SCOPE
     // ... is category + name
     //     or category
     //     or name
     //     or empty
-    #define QX_PERF_SCOPE(...) QX_EMPTY_MACRO
+    #ifdef QX_CONF_USE_PROFILER
+        #define QX_PERF_SCOPE(...) const qx::profiler_scope QX_LINE_NAME(_qxPerfScope)(__FUNCTION__, ##__VA_ARGS__)
+    #else
+        #define QX_PERF_SCOPE(...) QX_EMPTY_MACRO
+    #endif
 #endif
 
 #ifndef QX_PERF_FREE_MUTEX
-    #define QX_PERF_FREE_MUTEX(name) std::mutex name
+    #ifdef QX_CONF_USE_PERF_MUTEX
+        #define QX_PERF_FREE_MUTEX(name) qx::perf_mutex name { #name }
+    #else
+        #define QX_PERF_FREE_MUTEX(name) std::mutex name
+    #endif
 #endif
 
 #ifndef QX_PERF_FREE_SHARED_MUTEX
-    #define QX_PERF_FREE_SHARED_MUTEX(name) std::shared_mutex name
+    #ifdef QX_CONF_USE_PERF_MUTEX
+        #define QX_PERF_FREE_SHARED_MUTEX(name) qx::perf_shared_mutex name { #name }
+    #else
+        #define QX_PERF_FREE_SHARED_MUTEX(name) std::shared_mutex name
+    #endif
 #endif
 
 #ifndef QX_PERF_MUTEX
-    #define QX_PERF_MUTEX(name) mutable std::mutex name
+    #ifdef QX_CONF_USE_PERF_MUTEX
+        #define QX_PERF_MUTEX(name) mutable qx::perf_mutex name { #name }
+    #else
+        #define QX_PERF_MUTEX(name) mutable std::mutex name
+    #endif
 #endif
 
 #ifndef QX_PERF_SHARED_MUTEX
-    #define QX_PERF_SHARED_MUTEX(name) mutable std::shared_mutex name
+    #ifdef QX_CONF_USE_PERF_MUTEX
+        #define QX_PERF_SHARED_MUTEX(name) mutable qx::perf_shared_mutex name { #name }
+    #else
+        #define QX_PERF_SHARED_MUTEX(name) mutable std::shared_mutex name
+    #endif
 #endif
@@ -12,10 +12,15 @@
 #include <qx/containers/string/string_converters.h>
 #include <qx/internal/perf_scope.h>
 #include <qx/macros/suppress_warnings.h>
+#include <qx/smart_ptr/rcu.h>
 #include <qx/verbosity.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <ctime>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 
@@ -24,6 +29,13 @@ QX_DEFINE_CATEGORY(CatLogger, qx::color::dark_turquoise());
 namespace qx
 {
 
+enum class log_time_precision
+{
+    seconds,      //!< 17.10.2026_12:30:45
+    milliseconds, //!< 17.10.2026_12:30:45.123
+    microseconds, //!< 17.10.2026_12:30:45.123456
+};
+
 struct logger_color_range
 {
     std::pair<size_t, size_t> range { 0, 0 };
@@ -75,6 +87,12 @@ struct log_unit
 **/
 class base_logger_stream
 {
+    struct units_snapshot
+    {
+        std::unordered_map<string_hash, log_unit_info> units;
+        verbosity                                      eMinVerbosity = verbosity::none;
+    };
+
 public:
     static constexpr const char_type* k_svDefaultUnit = QX_TEXT("default");
 
@@ -85,13 +103,19 @@ public:
     **/
     base_logger_stream(bool bAlwaysFlush);
 
-    virtual ~base_logger_stream() = default;
+    virtual ~base_logger_stream();
 
     /**
         @brief Flush stream
     **/
     virtual void flush() = 0;
 
+    /**
+        @brief   Flush stream serialized with the output
+        @details Use it instead of flush() when other threads may be logging to this stream
+    **/
+    void locked_flush();
+
     /**
         @brief  Output to stream
         @tparam char_t       - char type, typically char or wchar_t
@@ -111,25 +135,72 @@ public:
         string_view     swLogMessage);
 
     /**
-        @brief Register logger unit
-        @param svUnitName - unit name (category name, file or function) 
-        @param unit       - unit info 
+        @brief  Output to stream with already resolved log unit
+        @param  logUnit      - log unit returned by get_unit_info() for this message
+        @param  eVerbosity   - message verbosity
+        @param  category     - code category
+        @param  svFile       - file name string
+        @param  svFunction   - function name string
+        @param  nLine        - code line number
+        @param  swLogMessage - formatted log line
+    **/
+    void log(
+        const log_unit& logUnit,
+        verbosity       eVerbosity,
+        const category& category,
+        string_view     svFile,
+        string_view     svFunction,
+        int             nLine,
+        string_view     swLogMessage);
+
+    /**
+        @brief   Output a line already formatted with the default line format
+        @details Lets the logger render the default line once per record and share it between streams
+        @param   logUnit    - log unit returned by get_unit_info() for this message
+        @param   eVerbosity - message verbosity
+        @param   buffers    - buffers filled by format_line() with this stream time precision
+    **/
+    void log_formatted(const log_unit& logUnit, verbosity eVerbosity, const logger_buffer& buffers);
+
+    /**
+        @brief  Check if lines of the log unit are formatted with the default line format
+        @param  logUnit - log unit returned by get_unit_info()
+        @retval         - true if the unit has no custom format function
+    **/
+    static bool has_default_format(const log_unit& logUnit) noexcept;
+
+    /**
+        @brief   Register logger unit
+        @details Units are replaced as a whole, so it's safe to call while other threads are logging.
+                 Waits for the read sections of all threads, so calling it inside a read section
+                 of the same thread (e.g. from do_log()) deadlocks
+        @param   svUnitName - unit name (category name, file or function) 
+        @param   unit       - unit info 
     **/
     void register_unit(string_view svUnitName, const log_unit_info& unit) noexcept;
 
     /**
-        @brief Deregister logger unit
-        @param svUnitName - unit name (category name, file or function)
+        @brief   Deregister logger unit
+        @details Waits for the read sections of all threads, so calling it inside a read section
+                 of the same thread (e.g. from do_log()) deadlocks
+        @param   svUnitName - unit name (category name, file or function)
     **/
     void deregister_unit(string_view svUnitName) noexcept;
 
     /**
-        @brief  Try to find log unit info based on trace location info
-        @param  category   - code category
-        @param  eVerbosity - message verbosity
-        @param  svFile     - file string
-        @param  svFunction - function string
-        @retval            - log unit info if found
+        @brief  Get min verbosity of all registered units
+        @retval - messages with lower verbosity will not be accepted by any unit
+    **/
+    verbosity get_min_verbosity() const noexcept;
+
+    /**
+        @brief   Try to find log unit info based on trace location info
+        @details Call inside rcu_read_guard, the found unit info stays valid until the guard is destroyed
+        @param   category   - code category
+        @param   eVerbosity - message verbosity
+        @param   svFile     - file string
+        @param   svFunction - function string
+        @retval             - log unit info if found
     **/
     std::optional<log_unit> get_unit_info(
         const category& category,
@@ -138,40 +209,88 @@ public:
         string_view     svFunction) const noexcept;
 
     /**
-        @brief  Format time string to the buffer
-        @param  sTime           - output time buffer
-        @param  chDateDelimiter - char to use as delimiter in date part
-        @param  chTimeDelimiter - char to use as delimiter in time part
+        @brief   Get generation of log units of all streams
+        @details Generation is changed every time any stream units or any logger streams are changed,
+                 so log units resolved with another generation may be outdated
+        @retval  - log units generation
     **/
-    static void append_time_string(string& sTime, char_type chDateDelimiter, char_type chTimeDelimiter) noexcept;
+    static u64 get_units_generation() noexcept;
+
+    /**
+        @brief Change log units generation to invalidate all resolved log units
+    **/
+    static void increment_units_generation() noexcept;
+
+    /**
+        @brief Set time precision used by the default line format
+        @param ePrecision - time precision
+    **/
+    void set_time_precision(log_time_precision ePrecision) noexcept;
+
+    /**
+        @brief  Get time precision used by the default line format
+        @retval  - time precision
+    **/
+    log_time_precision get_time_precision() const noexcept;
+
+    /**
+        @brief   Format time string to the buffer
+        @details Date and time are rendered once per second per thread and then reused,
+                 sub-second part is taken from the steady clock
+        @param   sTime           - output time buffer
+        @param   chDateDelimiter - char to use as delimiter in date part
+        @param   chTimeDelimiter - char to use as delimiter in time part
+        @param   ePrecision      - time precision
+    **/
+    static void append_time_string(
+        string&            sTime,
+        char_type          chDateDelimiter,
+        char_type          chTimeDelimiter,
+        log_time_precision ePrecision = log_time_precision::seconds) noexcept;
+
+    /**
+        @brief   Format logger line with the default line format
+        @details Doesn't depend on the stream, so the logger may render it once for all streams
+                 with the same time precision. Use log_unit_info::formatFunc to customize lines
+        @param   buffers      - string buffers to reduce num of allocations
+        @param   eVerbosity   - message verbosity
+        @param   category     - code category
+        @param   svFile       - file name string
+        @param   svFunction   - function name string
+        @param   nLine        - code line number
+        @param   swLogMessage - formatted log line
+        @param   ePrecision   - time precision
+    **/
+    static void format_line(
+        logger_buffer&     buffers,
+        verbosity          eVerbosity,
+        const category&    category,
+        string_view        svFile,
+        string_view        svFunction,
+        int                nLine,
+        string_view        swLogMessage,
+        log_time_precision ePrecision) noexcept;
 
 protected:
     /**
-        @brief  Get string buffers
+        @brief  Get string buffers of the current thread
         @retval        - string buffers
     **/
-    logger_buffer& get_log_buffer() noexcept;
+    static logger_buffer& get_log_buffer() noexcept;
+
+private:
+    /**
+        @brief  Get log units generation counter
+        @retval  - log units generation counter
+    **/
+    static std::atomic<u64>& get_units_generation_counter() noexcept;
 
     /**
-        @brief Format logger line
-        @param  buffers      - string buffers to reduce num of allocations
-        @param  eVerbosity   - message verbosity
-        @param  category     - code category
-        @param  svFile       - file name string
-        @param  svFunction   - function name string
-        @param  nLine        - code line number
-        @param  swLogMessage - formatted log line
+        @brief Publish new units and delete the old ones when no thread can read them
+        @param pUnits - new units
     **/
-    virtual void format_line(
-        logger_buffer&  buffers,
-        verbosity       eVerbosity,
-        const category& category,
-        string_view     svFile,
-        string_view     svFunction,
-        int             nLine,
-        string_view     swLogMessage) noexcept;
+    void replace_units(std::unique_ptr<units_snapshot> pUnits) noexcept;
 
-private:
     /**
         @brief Proceed stream logging
         @param svMessage  - message string
@@ -186,10 +305,11 @@ private:
         verbosity                              eVerbosity) = 0;
 
 private:
-    std::unordered_map<string_hash, log_unit_info> m_Units;
-    logger_buffer                                  m_Buffer;
+    std::atomic<const units_snapshot*> m_pUnits;
+    std::mutex                         m_UnitsMutex; // serializes units changes
     QX_PERF_MUTEX(m_LoggerStreamMutex);
-    bool m_bAlwaysFlush = false;
+    bool               m_bAlwaysFlush   = false;
+    log_time_precision m_eTimePrecision = log_time_precision::seconds;
 };
 
 } // namespace qx
@@ -12,11 +12,18 @@ QX_DEFINE_FILE_CATEGORY(CatLogger);
 namespace qx
 {
 
-inline base_logger_stream::base_logger_stream(bool bAlwaysFlush) : m_bAlwaysFlush(bAlwaysFlush)
+inline base_logger_stream::base_logger_stream(bool bAlwaysFlush)
+    : m_pUnits(new units_snapshot)
+    , m_bAlwaysFlush(bAlwaysFlush)
 {
     register_unit(k_svDefaultUnit, { verbosity::log });
 }
 
+inline base_logger_stream::~base_logger_stream()
+{
+    delete m_pUnits.load(std::memory_order_relaxed);
+}
+
 inline void base_logger_stream::log(
     verbosity       eVerbosity,
     const category& category,
@@ -25,55 +32,105 @@ inline void base_logger_stream::log(
     int             nLine,
     string_view     swLogMessage)
 {
-    QX_PERF_SCOPE("Log");
+    rcu_read_guard readGuard;
 
-    const auto optLogUnit = get_unit_info(category, eVerbosity, svFile, svFunction);
-    if (!optLogUnit)
-        return;
+    if (const auto optLogUnit = get_unit_info(category, eVerbosity, svFile, svFunction))
+        log(*optLogUnit, eVerbosity, category, svFile, svFunction, nLine, swLogMessage);
+}
 
-    std::lock_guard lock(m_LoggerStreamMutex);
+inline void base_logger_stream::log(
+    const log_unit& logUnit,
+    verbosity       eVerbosity,
+    const category& category,
+    string_view     svFile,
+    string_view     svFunction,
+    int             nLine,
+    string_view     swLogMessage)
+{
+    QX_PERF_SCOPE("Log");
 
+    // formatting is done in the thread buffer, so only the output is serialized
     auto& buffers = get_log_buffer();
     buffers.clear();
 
-    auto formatFunc = optLogUnit->pUnitInfo->formatFunc;
-    if (!formatFunc)
-    {
-        formatFunc = [this](
-                         logger_buffer&      buffers,
-                         verbosity           eVerbosity,
-                         const qx::category& category,
-                         string_view         svFile,
-                         string_view         svFunction,
-                         int                 nLine,
-                         string_view         swLogMessage)
-        {
-            format_line(buffers, eVerbosity, category, svFile, svFunction, nLine, swLogMessage);
-        };
-    }
-
     {
         QX_PERF_SCOPE("Log formatting");
-        formatFunc(buffers, eVerbosity, category, svFile, svFunction, nLine, swLogMessage);
-    }
 
-    if (!buffers.sMessage.empty())
-    {
-        do_log(buffers.sMessage, *optLogUnit, buffers.colors, eVerbosity);
-        if (m_bAlwaysFlush)
-            flush();
+        if (const auto& formatFunc = logUnit.pUnitInfo->formatFunc)
+            formatFunc(buffers, eVerbosity, category, svFile, svFunction, nLine, swLogMessage);
+        else
+            format_line(buffers, eVerbosity, category, svFile, svFunction, nLine, swLogMessage, m_eTimePrecision);
     }
+
+    log_formatted(logUnit, eVerbosity, buffers);
+}
+
+inline void base_logger_stream::log_formatted(
+    const log_unit&      logUnit,
+    verbosity            eVerbosity,
+    const logger_buffer& buffers)
+{
+    if (buffers.sMessage.empty())
+        return;
+
+    std::lock_guard lock(m_LoggerStreamMutex);
+
+    do_log(buffers.sMessage, logUnit, buffers.colors, eVerbosity);
+    if (m_bAlwaysFlush)
+        flush();
+}
+
+inline void base_logger_stream::locked_flush()
+{
+    std::lock_guard lock(m_LoggerStreamMutex);
+
+    flush();
+}
+
+inline bool base_logger_stream::has_default_format(const log_unit& logUnit) noexcept
+{
+    return !logUnit.pUnitInfo->formatFunc;
 }
 
 inline void base_logger_stream::register_unit(string_view svUnitName, const log_unit_info& unit) noexcept
 {
-    if (!svUnitName.empty())
-        m_Units.emplace(string_hash(svUnitName), unit);
+    if (svUnitName.empty())
+        return;
+
+    std::lock_guard lock(m_UnitsMutex);
+
+    const units_snapshot& units = *m_pUnits.load(std::memory_order_relaxed);
+    if (units.units.contains(string_hash(svUnitName)))
+        return;
+
+    auto pNewUnits = std::make_unique<units_snapshot>(units);
+    pNewUnits->units.emplace(string_hash(svUnitName), unit);
+    pNewUnits->eMinVerbosity = std::min(pNewUnits->eMinVerbosity, unit.eMinVerbosity);
+
+    replace_units(std::move(pNewUnits));
 }
 
 inline void base_logger_stream::deregister_unit(string_view svUnitName) noexcept
 {
-    m_Units.erase(string_hash(svUnitName));
+    std::lock_guard lock(m_UnitsMutex);
+
+    const units_snapshot& units = *m_pUnits.load(std::memory_order_relaxed);
+    if (!units.units.contains(string_hash(svUnitName)))
+        return;
+
+    auto pNewUnits = std::make_unique<units_snapshot>(units);
+    pNewUnits->units.erase(string_hash(svUnitName));
+
+    pNewUnits->eMinVerbosity = verbosity::none;
+    for (const auto& [hash, unit] : pNewUnits->units)
+        pNewUnits->eMinVerbosity = std::min(pNewUnits->eMinVerbosity, unit.eMinVerbosity);
+
+    replace_units(std::move(pNewUnits));
+}
+
+inline verbosity base_logger_stream::get_min_verbosity() const noexcept
+{
+    return m_pUnits.load(std::memory_order_acquire)->eMinVerbosity;
 }
 
 inline std::optional<log_unit> base_logger_stream::get_unit_info(
@@ -84,20 +141,27 @@ inline std::optional<log_unit> base_logger_stream::get_unit_info(
 {
     QX_PERF_SCOPE();
 
-    auto find_unit = [this](string_view svUnit)
+    const units_snapshot& units = *m_pUnits.load(std::memory_order_acquire);
+
+    // cheap checks to avoid hashing: category verbosity has top priority
+    // and no unit will accept a message below the min unit verbosity
+    if (eVerbosity < category.get_verbosity() || eVerbosity < units.eMinVerbosity)
+        return std::nullopt;
+
+    auto find_unit = [&units](string_view svUnit)
     {
-        return !svUnit.empty() ? m_Units.find(string_hash(svUnit)) : m_Units.cend();
+        return !svUnit.empty() ? units.units.find(string_hash(svUnit)) : units.units.cend();
     };
 
     std::optional<log_unit> optLogUnit = std::nullopt;
 
-    if (auto it = find_unit(category.get_name()); it != m_Units.cend())
+    if (auto it = find_unit(category.get_name()); it != units.units.cend())
         optLogUnit = { &it->second, category.get_name() };
-    else if (it = find_unit(svFile); it != m_Units.cend())
+    else if (it = find_unit(svFile); it != units.units.cend())
         optLogUnit = { &it->second, svFile };
-    else if (it = find_unit(svFunction); it != m_Units.cend())
+    else if (it = find_unit(svFunction); it != units.units.cend())
         optLogUnit = { &it->second, svFunction };
-    else if (it = find_unit(k_svDefaultUnit); it != m_Units.cend())
+    else if (it = find_unit(k_svDefaultUnit); it != units.units.cend())
         optLogUnit = { &it->second, k_svDefaultUnit };
 
     if (optLogUnit && optLogUnit->pUnitInfo && eVerbosity >= optLogUnit->pUnitInfo->eMinVerbosity)
@@ -106,43 +170,150 @@ inline std::optional<log_unit> base_logger_stream::get_unit_info(
         return std::nullopt;
 }
 
+inline u64 base_logger_stream::get_units_generation() noexcept
+{
+    return get_units_generation_counter().load(std::memory_order_acquire);
+}
+
+inline void base_logger_stream::increment_units_generation() noexcept
+{
+    get_units_generation_counter().fetch_add(1, std::memory_order_acq_rel);
+}
+
+inline void base_logger_stream::set_time_precision(log_time_precision ePrecision) noexcept
+{
+    m_eTimePrecision = ePrecision;
+}
+
+inline log_time_precision base_logger_stream::get_time_precision() const noexcept
+{
+    return m_eTimePrecision;
+}
+
 inline void base_logger_stream::append_time_string(
-    string&   sTime,
-    char_type chDateDelimiter,
-    char_type chTimeDelimiter) noexcept
-{
-    std::time_t t = std::time(nullptr);
-    QX_PUSH_SUPPRESS_MSVC_WARNINGS(4996);
-    std::tm* now = std::localtime(&t);
-    QX_POP_SUPPRESS_WARNINGS();
-
-    sTime.append_format(
-        QX_TEXT("{:02}{}{:02}{}{:04}_{:02}{}{:02}{}{:02}"),
-        now->tm_mday,
-        chDateDelimiter,
-        now->tm_mon,
-        chDateDelimiter,
-        now->tm_year + 1900,
-        now->tm_hour,
-        chTimeDelimiter,
-        now->tm_min,
-        chTimeDelimiter,
-        now->tm_sec);
+    string&            sTime,
+    char_type          chDateDelimiter,
+    char_type          chTimeDelimiter,
+    log_time_precision ePrecision) noexcept
+{
+    struct time_cache
+    {
+        std::chrono::steady_clock::time_point anchorSteadyTime;
+        std::chrono::system_clock::time_point anchorSystemTime;
+        std::chrono::seconds                  renderedSecond { -1 };
+        char_type                             chDateDelimiter = QX_TEXT('\0');
+        char_type                             chTimeDelimiter = QX_TEXT('\0');
+        string                                sRendered;
+    };
+
+    // localtime() is expensive and may take a global lock, so render only when the second changes
+    thread_local time_cache cache;
+
+    using system_duration = std::chrono::system_clock::duration;
+
+    const auto steadyNow = std::chrono::steady_clock::now();
+    const auto elapsed   = std::chrono::duration_cast<system_duration>(steadyNow - cache.anchorSteadyTime);
+    auto       systemNow = cache.anchorSystemTime + elapsed;
+    auto       second    = std::chrono::floor<std::chrono::seconds>(systemNow.time_since_epoch());
+
+    if (second != cache.renderedSecond || chDateDelimiter != cache.chDateDelimiter
+        || chTimeDelimiter != cache.chTimeDelimiter)
+    {
+        // anchor the steady clock to the system clock again to follow system time adjustments
+        cache.anchorSteadyTime = steadyNow;
+        cache.anchorSystemTime = std::chrono::system_clock::now();
+        systemNow              = cache.anchorSystemTime;
+        second                 = std::chrono::floor<std::chrono::seconds>(systemNow.time_since_epoch());
+
+        const std::time_t t   = static_cast<std::time_t>(second.count());
+        std::tm           now = {};
+#if QX_WIN
+        localtime_s(&now, &t);
+#else
+        localtime_r(&t, &now);
+#endif
+
+        cache.sRendered.clear();
+        cache.sRendered.append_format(
+            QX_TEXT("{:02}{}{:02}{}{:04}_{:02}{}{:02}{}{:02}"),
+            now.tm_mday,
+            chDateDelimiter,
+            now.tm_mon + 1,
+            chDateDelimiter,
+            now.tm_year + 1900,
+            now.tm_hour,
+            chTimeDelimiter,
+            now.tm_min,
+            chTimeDelimiter,
+            now.tm_sec);
+
+        cache.renderedSecond  = second;
+        cache.chDateDelimiter = chDateDelimiter;
+        cache.chTimeDelimiter = chTimeDelimiter;
+    }
+
+    sTime += cache.sRendered;
+
+    auto append_fraction = [&sTime](u64 nValue, size_t nDigits)
+    {
+        char_type szDigits[7] = { QX_TEXT('.') };
+        for (size_t i = nDigits; i > 0; --i)
+        {
+            szDigits[i] = static_cast<char_type>(QX_TEXT('0') + nValue % 10);
+            nValue /= 10;
+        }
+
+        sTime.append(szDigits, nDigits + 1);
+    };
+
+    const auto fraction = systemNow.time_since_epoch() - second;
+    switch (ePrecision)
+    {
+    case log_time_precision::milliseconds:
+        append_fraction(static_cast<u64>(std::chrono::duration_cast<std::chrono::milliseconds>(fraction).count()), 3);
+        break;
+
+    case log_time_precision::microseconds:
+        append_fraction(static_cast<u64>(std::chrono::duration_cast<std::chrono::microseconds>(fraction).count()), 6);
+        break;
+
+    default:
+        break;
+    }
+}
+
+inline std::atomic<u64>& base_logger_stream::get_units_generation_counter() noexcept
+{
+    // zero is never used, so it may be used as an invalid generation
+    static std::atomic<u64> nGeneration = 1;
+    return nGeneration;
+}
+
+inline void base_logger_stream::replace_units(std::unique_ptr<units_snapshot> pUnits) noexcept
+{
+    // units resolved before are invalidated by the generation, then the old units are deleted
+    // when no read section can have a pointer to them
+    std::unique_ptr<const units_snapshot> pOldUnits(m_pUnits.exchange(pUnits.release(), std::memory_order_acq_rel));
+    increment_units_generation();
+    rcu_synchronize();
 }
 
 inline logger_buffer& base_logger_stream::get_log_buffer() noexcept
 {
-    return m_Buffer;
+    // streams are called one after another, so one buffer per thread is enough for all of them
+    thread_local logger_buffer buffer;
+    return buffer;
 }
 
 inline void base_logger_stream::format_line(
-    logger_buffer&  buffers,
-    verbosity       eVerbosity,
-    const category& category,
-    string_view     svFile,
-    string_view     svFunction,
-    int             nLine,
-    string_view     swLogMessage) noexcept
+    logger_buffer&     buffers,
+    verbosity          eVerbosity,
+    const category&    category,
+    string_view        svFile,
+    string_view        svFunction,
+    int                nLine,
+    string_view        swLogMessage,
+    log_time_precision ePrecision) noexcept
 {
     switch (eVerbosity)
     {
@@ -175,7 +346,7 @@ inline void base_logger_stream::format_line(
         break;
     }
 
-    append_time_string(buffers.sMessage, QX_TEXT('.'), QX_TEXT(':'));
+    append_time_string(buffers.sMessage, QX_TEXT('.'), QX_TEXT(':'), ePrecision);
     buffers.sMessage += QX_TEXT("][");
 
     string_view svCategory = category.get_name();
@@ -0,0 +1,188 @@
+/**
+
+    @file      binary_log.h
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+#pragma once
+
+#include <qx/category.h>
+#include <qx/containers/string/format_string.h>
+#include <qx/containers/string/string.h>
+#include <qx/internal/cache_line.h>
+#include <qx/macros/copyable_movable.h>
+#include <qx/macros/suppress_warnings.h>
+#include <qx/typedefs.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+
+namespace qx
+{
+
+/**
+    @struct log_call_site
+    @brief  Static description of a binary log call site
+            Created once per call site, binary records keep only a pointer to it
+**/
+struct log_call_site
+{
+    verbosity   eVerbosity = verbosity::log;
+    category    logCategory;
+    string_view svFile;
+    string_view svFunction;
+    int         nLine = 0;
+    string_view svFormat;
+};
+
+template<class T>
+concept binary_log_arithmetic_arg = std::is_arithmetic_v<std::remove_cvref_t<T>>;
+
+template<class T>
+concept binary_log_string_arg =
+    !binary_log_arithmetic_arg<T> && std::is_convertible_v<const std::remove_reference_t<T>&, string_view>;
+
+template<class... args_t>
+concept binary_log_acceptable_args = format_acceptable_args<char_type, args_t...>
+                                     && ((binary_log_arithmetic_arg<args_t> || binary_log_string_arg<args_t>) && ...);
+
+namespace details
+{
+
+using binary_log_decode_func = void (*)(string_view svFormat, const std::byte* pArgs, string& sMessage);
+
+struct binary_log_record_header
+{
+    u32                    nSize       = 0; // whole record size, 0 marks skipped end of the buffer
+    const log_call_site*   pCallSite   = nullptr;
+    binary_log_decode_func pDecodeFunc = nullptr;
+};
+
+constexpr size_t k_nBinaryLogRecordAlignment = alignof(binary_log_record_header);
+
+/**
+    @brief  Get size of a binary record with these args
+    @tparam args_t - template parameter pack type
+    @param  args   - log args
+    @retval        - record size including the header and padding
+**/
+template<class... args_t>
+size_t get_binary_log_record_size(const args_t&... args) noexcept;
+
+/**
+    @brief  Write a binary record
+    @tparam args_t    - template parameter pack type
+    @param  pRecord   - record memory of get_binary_log_record_size() bytes
+    @param  nSize     - record size
+    @param  callSite  - log call site
+    @param  args      - log args
+**/
+template<class... args_t>
+void write_binary_log_record(
+    std::byte*           pRecord,
+    size_t               nSize,
+    const log_call_site& callSite,
+    const args_t&... args) noexcept;
+
+/**
+    @brief  Read args written by write_binary_log_record() and format them
+    @tparam args_t   - template parameter pack type used when writing
+    @param  svFormat - format string
+    @param  pArgs    - pointer to the first arg after the record header
+    @param  sMessage - string to append the formatted message to
+**/
+template<class... args_t>
+void decode_binary_log_args(string_view svFormat, const std::byte* pArgs, string& sMessage);
+
+// positions are aligned to cache lines, so the class is padded (C4324)
+QX_PUSH_SUPPRESS_MSVC_WARNINGS(4324);
+
+/**
+
+    @class   binary_log_buffer
+    @brief   Single producer single consumer ring buffer of variable size binary log records
+    @details Every record is contiguous: if a record doesn't fit in the buffer tail,
+             the tail is marked as skipped and the record is written from the beginning
+    @author  Khrapov
+    @date    17.10.2026
+
+**/
+class binary_log_buffer
+{
+public:
+    QX_NONCOPYMOVABLE(binary_log_buffer);
+
+    /**
+        @brief binary_log_buffer object constructor
+        @param nCapacity - buffer size in bytes, will be rounded up to the power of 2
+    **/
+    explicit binary_log_buffer(size_t nCapacity);
+
+    /**
+        @brief  Reserve contiguous memory for a record, producer side
+        @param  nSize - record size, must be a multiple of k_nBinaryLogRecordAlignment
+                        and not greater than max_record_size()
+        @retval       - record memory or nullptr if there is not enough free space
+    **/
+    std::byte* try_reserve(size_t nSize) noexcept;
+
+    /**
+        @brief Make the last reserved record visible to the consumer
+    **/
+    void commit() noexcept;
+
+    /**
+        @brief  Process all committed records, consumer side
+        @tparam consume_func_t - function type, void(const std::byte*)
+        @param  consumeFunc    - function processing a record
+        @retval                - true if there was at least one record
+    **/
+    template<class consume_func_t>
+    bool consume_all(consume_func_t&& consumeFunc);
+
+    /**
+        @brief  Check if there are no committed records
+        @retval  - true if there are no committed records
+    **/
+    bool empty() const noexcept;
+
+    /**
+        @brief  Get buffer size in bytes
+        @retval  - buffer size in bytes
+    **/
+    size_t capacity() const noexcept;
+
+    /**
+        @brief   Get max size of a record which fits in the buffer
+        @details A bigger record may need more than the whole buffer when it doesn't fit in the tail,
+                 so it may never be reserved
+        @retval  - max record size in bytes, half of the capacity
+    **/
+    size_t max_record_size() const noexcept;
+
+private:
+    std::unique_ptr<std::byte[]> m_pData;
+    size_t                       m_nMask = 0;
+
+    alignas(k_nCacheLineSize) std::atomic<size_t> m_nWritePos = 0;
+
+    // producer only
+    size_t m_nReservedEnd   = 0;
+    size_t m_nCachedReadPos = 0;
+
+    alignas(k_nCacheLineSize) std::atomic<size_t> m_nReadPos = 0;
+};
+
+QX_POP_SUPPRESS_WARNINGS();
+
+} // namespace details
+
+} // namespace qx
+
+#include <qx/logger/binary_log.inl>
@@ -0,0 +1,211 @@
+/**
+
+    @file      binary_log.inl
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+
+namespace qx::details
+{
+
+constexpr size_t align_binary_log_offset(size_t nOffset, size_t nAlignment) noexcept
+{
+    return (nOffset + nAlignment - 1) & ~(nAlignment - 1);
+}
+
+template<class T>
+using binary_log_decoded_t = std::conditional_t<binary_log_arithmetic_arg<T>, std::remove_cvref_t<T>, string_view>;
+
+template<class T>
+inline void add_binary_log_arg_size(size_t& nOffset, const T& value) noexcept
+{
+    if constexpr (binary_log_arithmetic_arg<T>)
+    {
+        nOffset += sizeof(T);
+    }
+    else
+    {
+        const string_view svValue = value;
+        nOffset = align_binary_log_offset(nOffset, alignof(u32)) + sizeof(u32) + svValue.size() * sizeof(char_type);
+    }
+}
+
+template<class T>
+inline void write_binary_log_arg(std::byte* pArgs, size_t& nOffset, const T& value) noexcept
+{
+    if constexpr (binary_log_arithmetic_arg<T>)
+    {
+        std::memcpy(pArgs + nOffset, &value, sizeof(T));
+        nOffset += sizeof(T);
+    }
+    else
+    {
+        const string_view svValue = value;
+        const u32         nSize   = static_cast<u32>(svValue.size());
+
+        nOffset = align_binary_log_offset(nOffset, alignof(u32));
+        std::memcpy(pArgs + nOffset, &nSize, sizeof(u32));
+        nOffset += sizeof(u32);
+
+        std::memcpy(pArgs + nOffset, svValue.data(), nSize * sizeof(char_type));
+        nOffset += nSize * sizeof(char_type);
+    }
+}
+
+template<class T>
+inline binary_log_decoded_t<T> read_binary_log_arg(const std::byte* pArgs, size_t& nOffset) noexcept
+{
+    if constexpr (binary_log_arithmetic_arg<T>)
+    {
+        std::remove_cvref_t<T> value;
+        std::memcpy(&value, pArgs + nOffset, sizeof(value));
+        nOffset += sizeof(value);
+        return value;
+    }
+    else
+    {
+        static_assert(alignof(char_type) <= alignof(u32), "String data must be aligned");
+
+        u32 nSize = 0;
+        nOffset   = align_binary_log_offset(nOffset, alignof(u32));
+        std::memcpy(&nSize, pArgs + nOffset, sizeof(u32));
+        nOffset += sizeof(u32);
+
+        const string_view svValue(reinterpret_cast<const char_type*>(pArgs + nOffset), nSize);
+        nOffset += nSize * sizeof(char_type);
+        return svValue;
+    }
+}
+
+template<class... args_t>
+inline size_t get_binary_log_record_size(const args_t&... args) noexcept
+{
+    size_t nSize = sizeof(binary_log_record_header);
+    (add_binary_log_arg_size(nSize, args), ...);
+    return align_binary_log_offset(nSize, k_nBinaryLogRecordAlignment);
+}
+
+template<class... args_t>
+inline void write_binary_log_record(
+    std::byte*           pRecord,
+    size_t               nSize,
+    const log_call_site& callSite,
+    const args_t&... args) noexcept
+{
+    binary_log_record_header header;
+    header.nSize       = static_cast<u32>(nSize);
+    header.pCallSite   = &callSite;
+    header.pDecodeFunc = &decode_binary_log_args<args_t...>;
+    std::memcpy(pRecord, &header, sizeof(header));
+
+    size_t nOffset = 0;
+    (write_binary_log_arg(pRecord + sizeof(header), nOffset, args), ...);
+}
+
+template<class... args_t>
+inline void decode_binary_log_args(string_view svFormat, const std::byte* pArgs, string& sMessage)
+{
+    // braced initialization guarantees left to right evaluation order
+    [[maybe_unused]] size_t                    nOffset = 0;
+    std::tuple<binary_log_decoded_t<args_t>...> args { read_binary_log_arg<args_t>(pArgs, nOffset)... };
+
+    std::apply(
+        [svFormat, &sMessage](const auto&... decodedArgs)
+        {
+            sMessage.append_vformat(svFormat, decodedArgs...);
+        },
+        args);
+}
+
+inline binary_log_buffer::binary_log_buffer(size_t nCapacity)
+{
+    size_t nRoundedCapacity = k_nCacheLineSize;
+    while (nRoundedCapacity < nCapacity)
+        nRoundedCapacity <<= 1;
+
+    m_pData = std::make_unique<std::byte[]>(nRoundedCapacity);
+    m_nMask = nRoundedCapacity - 1;
+}
+
+inline std::byte* binary_log_buffer::try_reserve(size_t nSize) noexcept
+{
+    const size_t nWritePos = m_nWritePos.load(std::memory_order_relaxed);
+    const size_t nIndex    = nWritePos & m_nMask;
+    const size_t nTail     = capacity() - nIndex;
+    const size_t nSkip     = nSize > nTail ? nTail : 0;
+    const size_t nRequired = nSkip + nSize;
+
+    if (nWritePos + nRequired - m_nCachedReadPos > capacity())
+    {
+        // read the shared position only when the cached one is not enough
+        m_nCachedReadPos = m_nReadPos.load(std::memory_order_acquire);
+        if (nWritePos + nRequired - m_nCachedReadPos > capacity())
+            return nullptr;
+    }
+
+    if (nSkip > 0)
+    {
+        const u32 nSkipMarker = 0;
+        std::memcpy(m_pData.get() + nIndex, &nSkipMarker, sizeof(nSkipMarker));
+    }
+
+    m_nReservedEnd = nWritePos + nRequired;
+    return m_pData.get() + ((nWritePos + nSkip) & m_nMask);
+}
+
+inline void binary_log_buffer::commit() noexcept
+{
+    m_nWritePos.store(m_nReservedEnd, std::memory_order_release);
+}
+
+template<class consume_func_t>
+inline bool binary_log_buffer::consume_all(consume_func_t&& consumeFunc)
+{
+    size_t       nReadPos  = m_nReadPos.load(std::memory_order_relaxed);
+    const size_t nWritePos = m_nWritePos.load(std::memory_order_acquire);
+
+    if (nReadPos == nWritePos)
+        return false;
+
+    while (nReadPos != nWritePos)
+    {
+        const size_t nIndex = nReadPos & m_nMask;
+
+        u32 nSize = 0;
+        std::memcpy(&nSize, m_pData.get() + nIndex, sizeof(nSize));
+
+        if (nSize == 0)
+        {
+            nReadPos += capacity() - nIndex;
+        }
+        else
+        {
+            consumeFunc(static_cast<const std::byte*>(m_pData.get() + nIndex));
+            nReadPos += nSize;
+        }
+
+        // free the space as soon as possible, the producer may be waiting for it
+        m_nReadPos.store(nReadPos, std::memory_order_release);
+    }
+
+    return true;
+}
+
+inline bool binary_log_buffer::empty() const noexcept
+{
+    return m_nReadPos.load(std::memory_order_acquire) == m_nWritePos.load(std::memory_order_acquire);
+}
+
+inline size_t binary_log_buffer::capacity() const noexcept
+{
+    return m_nMask + 1;
+}
+
+inline size_t binary_log_buffer::max_record_size() const noexcept
+{
+    return capacity() / 2;
+}
+
+} // namespace qx::details
@@ -11,7 +11,9 @@
 #include <qx/logger/base_logger_stream.h>
 #include <qx/logger/terminal_color.h>
 
+#include <array>
 #include <iostream>
+#include <unordered_map>
 
 namespace qx
 {
@@ -20,6 +22,8 @@ namespace qx
 
     @class   cout_logger_stream
     @brief   Logger stream for std::cout output
+    @details Escape sequences are rendered once per color,
+             every line is assembled in one buffer and written with one call
     @author  Khrapov
     @date    28.07.2021
 
@@ -56,7 +60,43 @@ public:
     void set_using_colors(bool bUsingColors) noexcept;
 
 private:
-    bool m_bUsingColors = true;
+    using color_sequence = terminal_color::sequence<char_type>;
+
+    /**
+        @brief  Get cout stream of the char type
+        @retval - std::cout or std::wcout
+    **/
+    static std::basic_ostream<char_type>& get_cout() noexcept;
+
+    /**
+        @brief  Get common color of messages with this verbosity
+        @param  eVerbosity - message verbosity
+        @retval            - common message color
+    **/
+    static constexpr color get_verbosity_color(verbosity eVerbosity) noexcept;
+
+    /**
+        @brief  Get cached font escape sequence of the color
+        @param  fontColor - font color
+        @retval           - escape sequence view
+    **/
+    string_view get_font_sequence(const color& fontColor);
+
+    /**
+        @brief Append a message part surrounded with its color and reset sequences to the line
+        @param svPart     - message part
+        @param svSequence - part color escape sequence
+    **/
+    void append_colorized(string_view svPart, string_view svSequence);
+
+private:
+    static constexpr size_t k_nVerbosities = static_cast<size_t>(verbosity::none) + 1;
+
+    bool                                             m_bUsingColors = true;
+    std::array<color_sequence, k_nVerbosities>       m_VerbositySequences;
+    std::unordered_map<unsigned int, color_sequence> m_FontSequences;
+    color_sequence                                   m_ResetSequence;
+    string                                           m_sLine;
 };
 
 } // namespace qx
@@ -17,7 +17,14 @@ inline cout_logger_stream::cout_logger_stream(
     bool bUntieCin)
     : base_logger_stream(bAlwaysFlush)
     , m_bUsingColors(bUseColors)
+    , m_ResetSequence(terminal_color::reset().get_sequence<char_type>())
 {
+    for (size_t i = 0; i < m_VerbositySequences.size(); ++i)
+    {
+        m_VerbositySequences[i] =
+            terminal_color::font(get_verbosity_color(static_cast<verbosity>(i))).get_sequence<char_type>();
+    }
+
     if (bDisableStdioSync)
     {
         // Optimization
@@ -30,7 +37,9 @@ inline cout_logger_stream::cout_logger_stream(
         // This unties cin from cout.
         // Tied streams ensure that one stream is flushed automatically
         // before each I/O operation on the other stream
+        std::cin.tie(nullptr);
         std::wcin.tie(nullptr);
+        std::cout.tie(nullptr);
         std::wcout.tie(nullptr);
     }
 }
@@ -39,7 +48,7 @@ inline void cout_logger_stream::flush()
 {
     QX_PERF_SCOPE(CatLogger, "Flush to cout");
 
-    std::wcout << std::flush;
+    get_cout() << std::flush;
 }
 
 inline void cout_logger_stream::do_log(
@@ -50,61 +59,32 @@ inline void cout_logger_stream::do_log(
 {
     QX_PERF_SCOPE(CatLogger, "Log to cout");
 
-    thread_local wstring sWideMessage;
-    sWideMessage = to_wstring(svMessage);
-
-    if (m_bUsingColors)
+    if (!m_bUsingColors)
     {
-        color commonColor = color::white();
-        switch (eVerbosity)
-        {
-        case verbosity::very_verbose:
-        case verbosity::verbose:
-            commonColor = color::gray();
-            break;
-
-        case verbosity::log:
-            commonColor = color::white();
-            break;
-
-        case verbosity::important:
-            commonColor = color::khaki();
-            break;
-
-        case verbosity::warning:
-            commonColor = color::orange();
-            break;
-
-        case verbosity::error:
-            commonColor = color::crimson();
-            break;
-
-        case verbosity::critical:
-            commonColor = color::dark_red();
-            break;
-        }
-
-        auto cout_colorized = [](size_t nStart, size_t nEnd, const color& rangeColor)
-        {
-            std::wcout << terminal_color::font(rangeColor)
-                       << qx::wstring_view { sWideMessage.data() + nStart, nEnd - nStart } << terminal_color::reset();
-        };
-
-        cout_colorized(0, colors.empty() ? sWideMessage.size() : colors.front().range.first, commonColor);
-
-        for (size_t i = 0; i < colors.size(); ++i)
-        {
-            cout_colorized(colors[i].range.first, colors[i].range.second, colors[i].rangeColor);
-            cout_colorized(
-                colors[i].range.second,
-                i + 1 < colors.size() ? colors[i + 1].range.first : sWideMessage.size(),
-                commonColor);
-        }
+        get_cout().write(svMessage.data(), static_cast<std::streamsize>(svMessage.size()));
+        return;
     }
-    else
+
+    const string_view svCommonSequence = m_VerbositySequences[static_cast<size_t>(eVerbosity)].view();
+
+    m_sLine.clear();
+    append_colorized(
+        svMessage.substr(0, colors.empty() ? svMessage.size() : colors.front().range.first),
+        svCommonSequence);
+
+    for (size_t i = 0; i < colors.size(); ++i)
     {
-        std::wcout << sWideMessage;
+        const size_t nRangeStart = colors[i].range.first;
+        const size_t nRangeEnd   = colors[i].range.second;
+        const size_t nNextStart  = i + 1 < colors.size() ? colors[i + 1].range.first : svMessage.size();
+
+        append_colorized(
+            svMessage.substr(nRangeStart, nRangeEnd - nRangeStart),
+            get_font_sequence(colors[i].rangeColor));
+        append_colorized(svMessage.substr(nRangeEnd, nNextStart - nRangeEnd), svCommonSequence);
     }
+
+    get_cout().write(m_sLine.data(), static_cast<std::streamsize>(m_sLine.size()));
 }
 
 inline void cout_logger_stream::set_using_colors(bool bUsingColors) noexcept
@@ -112,4 +92,60 @@ inline void cout_logger_stream::set_using_colors(bool bUsingColors) noexcept
     m_bUsingColors = bUsingColors;
 }
 
+inline std::basic_ostream<char_type>& cout_logger_stream::get_cout() noexcept
+{
+#ifdef QX_CONF_USE_WCHAR
+    return std::wcout;
+#else
+    return std::cout;
+#endif
+}
+
+constexpr color cout_logger_stream::get_verbosity_color(verbosity eVerbosity) noexcept
+{
+    switch (eVerbosity)
+    {
+    case verbosity::very_verbose:
+    case verbosity::verbose:
+        return color::gray();
+
+    case verbosity::important:
+        return color::khaki();
+
+    case verbosity::warning:
+        return color::orange();
+
+    case verbosity::error:
+        return color::crimson();
+
+    case verbosity::critical:
+        return color::dark_red();
+
+    default:
+        return color::white();
+    }
+}
+
+inline string_view cout_logger_stream::get_font_sequence(const color& fontColor)
+{
+    // there are usually a few category colors, so the cache stays small
+    const unsigned int nColor = fontColor.hex_rgb();
+
+    auto it = m_FontSequences.find(nColor);
+    if (it == m_FontSequences.end())
+        it = m_FontSequences.emplace(nColor, terminal_color::font(fontColor).get_sequence<char_type>()).first;
+
+    return it->second.view();
+}
+
+inline void cout_logger_stream::append_colorized(string_view svPart, string_view svSequence)
+{
+    if (svPart.empty())
+        return;
+
+    m_sLine.append(svSequence.data(), svSequence.size());
+    m_sLine.append(svPart.data(), svPart.size());
+    m_sLine.append(m_ResetSequence.szData, m_ResetSequence.nSize);
+}
+
 } // namespace qx
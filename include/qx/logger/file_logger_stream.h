@@ -9,9 +9,27 @@
 #pragma once
 
 #include <qx/logger/base_logger_stream.h>
+#include <qx/macros/copyable_movable.h>
 
+#include <chrono>
+#include <condition_variable>
 #include <filesystem>
-#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if QX_WIN
+    #include <fcntl.h>
+    #include <io.h>
+    #include <windows.h>
+#else
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <sys/uio.h>
+    #include <unistd.h>
+#endif
 
 namespace qx
 {
@@ -23,10 +41,33 @@ enum class log_file_policy
     time_name,         //!< create new file with time name
 };
 
+enum class log_file_sync_policy
+{
+    none,      //!< leave writing data to the disk to the OS
+    data_sync, //!< wait for data to reach the disk on every flush, survives OS crashes and power loss
+};
+
+/**
+    @struct  log_file_rotation
+    @brief   Log file rotation settings
+    @details The current file is always "name.log", rotated files are "name.1.log" (the newest) ... "name.N.log".
+             Rotation is disabled if both the size and the interval are zero
+**/
+struct log_file_rotation
+{
+    size_t                              nMaxFileSize = 0;  //!< rotate when the file reaches this size in bytes
+    std::chrono::system_clock::duration interval     = {}; //!< rotate when this time passes after opening the file
+    size_t                              nMaxFiles    = 5;  //!< number of rotated files to keep
+};
+
 /**
 
     @class   file_logger_stream
     @brief   Logger stream for file output
+    @details Messages are encoded to UTF-8 right into a userspace buffer,
+             which is written to the file descriptor when it's full or on flush.
+             With rotation enabled the next file is opened ahead of time and renames are made by another thread,
+             so the logging thread only swaps file descriptors
     @author  Khrapov
     @date    28.07.2021
 
@@ -34,16 +75,27 @@ enum class log_file_policy
 class file_logger_stream : public base_logger_stream
 {
 public:
+    static constexpr size_t k_nDefaultBufferSize = 1024 * 1024;
+
+public:
+    QX_NONCOPYMOVABLE(file_logger_stream);
+
     /**
         @brief file_logger_stream object constructor
         @param bAlwaysFlush   - true if need to flush after every output, decreases performance
         @param eLogFilePolicy - policy to use
         @param svFileName     - log file name
+        @param nBufferSize    - size of the buffer of UTF-8 data in bytes
+        @param eSyncPolicy    - what flush guarantees
+        @param rotation       - log file rotation settings
     **/
     file_logger_stream(
-        bool            bAlwaysFlush   = false,
-        log_file_policy eLogFilePolicy = log_file_policy::append,
-        string_view     svFileName     = L"application");
+        bool                     bAlwaysFlush   = false,
+        log_file_policy          eLogFilePolicy = log_file_policy::append,
+        string_view              svFileName     = L"application",
+        size_t                   nBufferSize    = k_nDefaultBufferSize,
+        log_file_sync_policy     eSyncPolicy    = log_file_sync_policy::none,
+        const log_file_rotation& rotation       = {});
 
     virtual ~file_logger_stream() override;
 
@@ -57,7 +109,91 @@ public:
         verbosity                              eVerbosity) override;
 
 private:
-    std::wofstream m_File;
+    struct rotation_state
+    {
+        std::mutex              mutex;
+        std::condition_variable condition;
+        std::thread             worker;
+        int                     nSpareFile   = -1; // opened by the worker, taken by the logging thread
+        int                     nRetiredFile = -1; // given by the logging thread, closed by the worker
+        bool                    bStop        = false;
+    };
+
+private:
+    /**
+        @brief  Open a file for appending
+        @param  path      - file path
+        @param  bTruncate - true if the file must be cleared
+        @retval           - file descriptor or -1 on failure
+    **/
+    static int open_file(const std::filesystem::path& path, bool bTruncate) noexcept;
+
+    /**
+        @brief Close a file
+        @param nFile - file descriptor
+    **/
+    static void close_file(int nFile) noexcept;
+
+    /**
+        @brief Write data to the file with one system call if possible
+        @param svData - data to write
+        @param svTail - data to write after svData
+    **/
+    void write_to_file(cstring_view svData, cstring_view svTail = {}) noexcept;
+
+    /**
+        @brief Wait for written data to reach the disk if the sync policy requires it
+        @param nFile - file descriptor
+    **/
+    void sync_file(int nFile) noexcept;
+
+    /**
+        @brief  Check if the current file must be rotated
+        @retval - true if the file must be rotated
+    **/
+    bool is_rotation_needed() const noexcept;
+
+    /**
+        @brief Switch to the file opened by the rotation worker if it's ready, never waits
+    **/
+    void try_rotate() noexcept;
+
+    /**
+        @brief Rotation thread function: closes retired files, renames and removes rotated files, opens spare files
+    **/
+    void rotation_worker_loop();
+
+    /**
+        @brief Rename files after the current file is retired
+    **/
+    void shift_rotated_files();
+
+    /**
+        @brief  Get path of a rotated file
+        @param  nIndex - 1 for the newest rotated file
+        @retval        - rotated file path
+    **/
+    std::filesystem::path get_rotated_file_path(size_t nIndex) const;
+
+    /**
+        @brief  Get path of the file opened ahead of time for the next rotation
+        @retval - spare file path
+    **/
+    std::filesystem::path get_spare_file_path() const;
+
+private:
+    int                     m_nFile     = -1;
+    u64                     m_nFileSize = 0;
+    std::unique_ptr<char[]> m_pBuffer;
+    size_t                  m_nBufferCapacity = 0;
+    size_t                  m_nBufferSize     = 0;
+    std::vector<char>       m_LongMessage;
+    log_file_sync_policy    m_eSyncPolicy = log_file_sync_policy::none;
+
+    std::filesystem::path                 m_Path;
+    log_file_rotation                     m_Rotation;
+    std::chrono::system_clock::time_point m_NextRotationTime;
+    std::unique_ptr<rotation_state>       m_pRotationState;
 };
 
 } // namespace qx
@@ -10,16 +10,26 @@
 namespace qx
 {
 
-inline file_logger_stream::file_logger_stream(bool bAlwaysFlush, log_file_policy eLogFilePolicy, string_view svFileName)
+inline file_logger_stream::file_logger_stream(
+    bool                     bAlwaysFlush,
+    log_file_policy          eLogFilePolicy,
+    string_view              svFileName,
+    size_t                   nBufferSize,
+    log_file_sync_policy     eSyncPolicy,
+    const log_file_rotation& rotation)
     : base_logger_stream(bAlwaysFlush)
+    , m_pBuffer(std::make_unique_for_overwrite<char[]>(nBufferSize))
+    , m_nBufferCapacity(nBufferSize)
+    , m_eSyncPolicy(eSyncPolicy)
+    , m_Rotation(rotation)
 {
-    string                  sLogFile    = svFileName;
-    std::ios_base::openmode openingMode = std::ios_base::app;
+    string sLogFile  = svFileName;
+    bool   bTruncate = false;
     switch (eLogFilePolicy)
     {
     case log_file_policy::clear_then_uppend:
     {
-        openingMode = std::ios_base::trunc;
+        bTruncate = true;
     }
     break;
 
@@ -36,39 +46,82 @@ inline file_logger_stream::file_logger_stream(bool bAlwaysFlush, log_file_policy
 
     sLogFile += L".log";
 
-    const wstring               sWideLogFile = to_wstring(sLogFile);
-    const std::filesystem::path path(sWideLogFile.c_str());
-    if (path.has_parent_path() && !std::filesystem::exists(path.parent_path()))
+    const wstring sWideLogFile = to_wstring(sLogFile);
+    m_Path                     = std::filesystem::path(sWideLogFile.c_str());
+    if (m_Path.has_parent_path() && !std::filesystem::exists(m_Path.parent_path()))
     {
-        if (!std::filesystem::create_directory(path.parent_path()))
+        if (!std::filesystem::create_directory(m_Path.parent_path()))
         {
             std::wcerr << L"Can't create output folder " << sWideLogFile;
             return;
         }
     }
 
-    m_File = std::basic_ofstream<wchar_t>(path, openingMode);
-    if (!m_File)
+    m_nFile = open_file(m_Path, bTruncate);
+    if (m_nFile < 0)
     {
         std::wcerr << L"Can't open log file " << sWideLogFile;
         return;
     }
 
-    QX_DISABLE_MSVC_WARNINGS(4996);
-    m_File.imbue(std::locale(std::locale(), new std::codecvt_utf8<wchar_t>));
-    QX_RESTORE_MSVC_WARNINGS(4996);
+    std::error_code errorCode;
+    m_nFileSize = std::filesystem::file_size(m_Path, errorCode);
+    if (errorCode)
+        m_nFileSize = 0;
+
+    if (m_Rotation.nMaxFileSize > 0 || m_Rotation.interval > std::chrono::system_clock::duration::zero())
+    {
+        m_NextRotationTime        = std::chrono::system_clock::now() + m_Rotation.interval;
+        m_pRotationState         = std::make_unique<rotation_state>();
+        m_pRotationState->worker = std::thread(
+            [this]()
+            {
+                rotation_worker_loop();
+            });
+    }
 }
 
 inline file_logger_stream::~file_logger_stream()
 {
-    if (m_File)
-        m_File << L"\n\n\n" << std::flush;
+    if (m_nFile >= 0)
+    {
+        write_to_file(cstring_view(m_pBuffer.get(), m_nBufferSize), "\n\n\n");
+        sync_file(m_nFile);
+        close_file(m_nFile);
+    }
+
+    if (m_pRotationState)
+    {
+        {
+            std::lock_guard lock(m_pRotationState->mutex);
+            m_pRotationState->bStop = true;
+        }
+
+        // the worker handles the retired file first, so the last file gets its final name
+        m_pRotationState->condition.notify_one();
+        m_pRotationState->worker.join();
+
+        if (m_pRotationState->nSpareFile >= 0)
+        {
+            close_file(m_pRotationState->nSpareFile);
+
+            std::error_code errorCode;
+            std::filesystem::remove(get_spare_file_path(), errorCode);
+        }
+    }
 }
 
 inline void file_logger_stream::flush()
 {
     QX_PERF_SCOPE(CatLogger, "Flush to the file");
-    m_File << std::flush;
+
+    if (m_nFile < 0)
+        return;
+
+    write_to_file(cstring_view(m_pBuffer.get(), m_nBufferSize));
+    m_nBufferSize = 0;
+
+    sync_file(m_nFile);
 }
 
 inline void file_logger_stream::do_log(
@@ -78,7 +131,243 @@ inline void file_logger_stream::do_log(
     verbosity                              eVerbosity)
 {
     QX_PERF_SCOPE(CatLogger, "Log to the file");
-    m_File << qx::to_wstring(svMessage);
+
+    if (m_nFile < 0)
+        return;
+
+    if (is_rotation_needed())
+        try_rotate();
+
+    const size_t nMaxSize = get_max_utf8_size<char_type>(svMessage.size());
+    if (m_nBufferSize + nMaxSize > m_nBufferCapacity)
+    {
+        if (nMaxSize > m_nBufferCapacity)
+        {
+            // the message doesn't fit even in the empty buffer, write them both with one call
+            if (m_LongMessage.size() < nMaxSize)
+                m_LongMessage.resize(nMaxSize);
+
+            const size_t nSize = encode_utf8(svMessage, m_LongMessage.data());
+            write_to_file(cstring_view(m_pBuffer.get(), m_nBufferSize), cstring_view(m_LongMessage.data(), nSize));
+            m_nBufferSize = 0;
+            return;
+        }
+
+        write_to_file(cstring_view(m_pBuffer.get(), m_nBufferSize));
+        m_nBufferSize = 0;
+    }
+
+    m_nBufferSize += encode_utf8(svMessage, m_pBuffer.get() + m_nBufferSize);
+}
+
+inline int file_logger_stream::open_file(const std::filesystem::path& path, bool bTruncate) noexcept
+{
+#if QX_WIN
+    // FILE_SHARE_DELETE allows the rotation worker to rename the file while it's open
+    const HANDLE hFile = CreateFileW(
+        path.c_str(),
+        FILE_APPEND_DATA,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        nullptr,
+        bTruncate ? CREATE_ALWAYS : OPEN_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr);
+
+    if (hFile == INVALID_HANDLE_VALUE)
+        return -1;
+
+    const int nFile = _open_osfhandle(reinterpret_cast<intptr_t>(hFile), _O_APPEND);
+    if (nFile < 0)
+        CloseHandle(hFile);
+
+    return nFile;
+#else
+    return open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC | (bTruncate ? O_TRUNC : 0), 0644);
+#endif
+}
+
+inline void file_logger_stream::close_file(int nFile) noexcept
+{
+#if QX_WIN
+    _close(nFile);
+#else
+    close(nFile);
+#endif
+}
+
+inline void file_logger_stream::write_to_file(cstring_view svData, cstring_view svTail) noexcept
+{
+#if QX_WIN
+    for (cstring_view svPart : { svData, svTail })
+    {
+        while (!svPart.empty())
+        {
+            const auto nChunkSize = static_cast<unsigned int>(std::min<size_t>(svPart.size(), 1u << 30));
+            const int  nWritten   = _write(m_nFile, svPart.data(), nChunkSize);
+            if (nWritten <= 0)
+                return;
+
+            svPart.remove_prefix(static_cast<size_t>(nWritten));
+            m_nFileSize += static_cast<u64>(nWritten);
+        }
+    }
+#else
+    iovec parts[] = { { const_cast<char*>(svData.data()), svData.size() },
+                      { const_cast<char*>(svTail.data()), svTail.size() } };
+
+    iovec* pParts = parts;
+    int    nParts = static_cast<int>(std::size(parts));
+    while (nParts > 0)
+    {
+        const ssize_t nWritten = writev(m_nFile, pParts, nParts);
+        if (nWritten < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            return;
+        }
+
+        m_nFileSize += static_cast<u64>(nWritten);
+
+        // writes may be partial, skip only what is written
+        auto nSkip = static_cast<size_t>(nWritten);
+        while (nParts > 0 && nSkip >= pParts->iov_len)
+        {
+            nSkip -= pParts->iov_len;
+            ++pParts;
+            --nParts;
+        }
+
+        if (nParts > 0)
+        {
+            pParts->iov_base = static_cast<char*>(pParts->iov_base) + nSkip;
+            pParts->iov_len -= nSkip;
+        }
+    }
+#endif
+}
+
+inline void file_logger_stream::sync_file(int nFile) noexcept
+{
+    if (m_eSyncPolicy != log_file_sync_policy::data_sync)
+        return;
+
+#if QX_WIN
+    _commit(nFile);
+#elif QX_MACOS
+    fsync(nFile);
+#else
+    fdatasync(nFile);
+#endif
+}
+
+inline bool file_logger_stream::is_rotation_needed() const noexcept
+{
+    if (!m_pRotationState)
+        return false;
+
+    if (m_Rotation.nMaxFileSize > 0 && m_nFileSize + m_nBufferSize >= m_Rotation.nMaxFileSize)
+        return true;
+
+    return m_Rotation.interval > std::chrono::system_clock::duration::zero()
+           && std::chrono::system_clock::now() >= m_NextRotationTime;
+}
+
+inline void file_logger_stream::try_rotate() noexcept
+{
+    QX_PERF_SCOPE(CatLogger, "Rotate the file");
+
+    rotation_state& state = *m_pRotationState;
+
+    // never wait for the worker: if it's busy or the next file is not opened yet, the next message will try again
+    std::unique_lock lock(state.mutex, std::try_to_lock);
+    if (!lock.owns_lock() || state.nSpareFile < 0)
+        return;
+
+    write_to_file(cstring_view(m_pBuffer.get(), m_nBufferSize));
+    m_nBufferSize = 0;
+
+    state.nRetiredFile = std::exchange(m_nFile, std::exchange(state.nSpareFile, -1));
+    m_nFileSize        = 0;
+    m_NextRotationTime = std::chrono::system_clock::now() + m_Rotation.interval;
+
+    lock.unlock();
+    state.condition.notify_one();
+}
+
+inline void file_logger_stream::rotation_worker_loop()
+{
+    rotation_state& state = *m_pRotationState;
+
+    int nRetiredFile = -1;
+    while (true)
+    {
+        if (nRetiredFile >= 0)
+        {
+            sync_file(nRetiredFile);
+            close_file(nRetiredFile);
+            shift_rotated_files();
+        }
+
+        std::unique_lock lock(state.mutex);
+        if (state.bStop)
+            break;
+
+        if (state.nSpareFile < 0)
+        {
+            // the spare file may be taken only after the previous one got the main file name
+            lock.unlock();
+            const int nSpareFile = open_file(get_spare_file_path(), true);
+            if (nSpareFile < 0)
+                std::wcerr << L"Can't open log file " << get_spare_file_path().wstring();
+
+            lock.lock();
+            state.nSpareFile = nSpareFile;
+        }
+
+        state.condition.wait(
+            lock,
+            [&state]()
+            {
+                return state.bStop || state.nRetiredFile >= 0;
+            });
+
+        nRetiredFile = std::exchange(state.nRetiredFile, -1);
+    }
+}
+
+inline void file_logger_stream::shift_rotated_files()
+{
+    QX_PERF_SCOPE(CatLogger, "Shift rotated files");
+
+    std::error_code errorCode;
+    if (m_Rotation.nMaxFiles == 0)
+    {
+        std::filesystem::remove(m_Path, errorCode);
+    }
+    else
+    {
+        std::filesystem::remove(get_rotated_file_path(m_Rotation.nMaxFiles), errorCode);
+
+        for (size_t i = m_Rotation.nMaxFiles - 1; i > 0; --i)
+            std::filesystem::rename(get_rotated_file_path(i), get_rotated_file_path(i + 1), errorCode);
+
+        std::filesystem::rename(m_Path, get_rotated_file_path(1), errorCode);
+    }
+
+    // the logging thread already writes to the spare file
+    std::filesystem::rename(get_spare_file_path(), m_Path, errorCode);
+}
+
+inline std::filesystem::path file_logger_stream::get_rotated_file_path(size_t nIndex) const
+{
+    return std::filesystem::path(m_Path).replace_extension(std::to_string(nIndex) + ".log");
+}
+
+inline std::filesystem::path file_logger_stream::get_spare_file_path() const
+{
+    return std::filesystem::path(m_Path).replace_extension("next.log");
 }
 
 } // namespace qx
@@ -0,0 +1,120 @@
+/**
+
+    @file      flight_recorder_logger_stream.h
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+#pragma once
+
+#include <qx/logger/base_logger_stream.h>
+#include <qx/logger/log_rate_limit.h>
+#include <qx/macros/copyable_movable.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+
+#if QX_WIN
+    #include <fcntl.h>
+    #include <io.h>
+    #include <sys/stat.h>
+#else
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace qx
+{
+
+/**
+
+    @class   flight_recorder_logger_stream
+    @brief   Logger stream keeping the last messages in a preallocated memory ring buffer
+    @details Logging to this stream is a copy to memory, so it may record very verbose messages
+             which are too expensive to write to a file. The buffer is dumped to a file on demand
+             or automatically when a message with the dump verbosity is logged (QX_EXPECT and QX_ASSERT failures),
+             automatic dumps are done at most once per dump period.
+             Writes are serialized by the base_logger_stream mutex as in other streams.
+             Only dumping is lock-free: it doesn't lock or allocate, so it may be called from a signal handler
+             while another thread is writing
+    @author  Khrapov
+    @date    17.10.2026
+
+**/
+class flight_recorder_logger_stream : public base_logger_stream
+{
+public:
+    static constexpr size_t k_nDefaultCapacity = 4 * 1024 * 1024;
+
+public:
+    QX_NONCOPYMOVABLE(flight_recorder_logger_stream);
+
+    /**
+        @brief flight_recorder_logger_stream object constructor
+        @param nCapacity      - buffer size in chars
+        @param eDumpVerbosity - messages with this or higher verbosity dump the buffer, verbosity::none to disable
+        @param svDumpFileName - dump file name without extension
+        @param dumpPeriod     - min period between automatic dumps
+    **/
+    flight_recorder_logger_stream(
+        size_t                              nCapacity      = k_nDefaultCapacity,
+        verbosity                           eDumpVerbosity = verbosity::error,
+        string_view                         svDumpFileName = QX_TEXT("flight_recorder"),
+        std::chrono::steady_clock::duration dumpPeriod     = std::chrono::seconds(1));
+
+    // base_logger_stream
+    //
+    virtual void flush() override;
+    virtual void do_log(
+        string_view                            svMessage,
+        const log_unit&                        logUnit,
+        const std::vector<logger_color_range>& colors,
+        verbosity                              eVerbosity) override;
+
+    /**
+        @brief   Rewrite the dump file with the buffer content
+        @details Async signal safe on POSIX systems
+        @retval  - true if the dump file is written
+    **/
+    bool dump() const noexcept;
+
+    /**
+        @brief   Write the buffer content in UTF-8 to a file
+        @details Async signal safe on POSIX systems, doesn't lock or allocate.
+                 Messages overwritten by the logging thread during dumping are skipped
+        @param   nFile - file descriptor
+    **/
+    void dump(int nFile) const noexcept;
+
+    /**
+        @brief  Get buffer size
+        @retval  - buffer size in chars
+    **/
+    size_t capacity() const noexcept;
+
+private:
+    /**
+        @brief  Get a number of the oldest char which is still in the buffer
+        @param  nEnd - number of the char after the last written one
+        @retval      - number of the oldest char
+    **/
+    u64 get_oldest_position(u64 nEnd) const noexcept;
+
+private:
+    std::unique_ptr<char_type[]> m_pBuffer;
+    size_t                       m_nCapacity      = 0;
+    std::atomic<u64>             m_nWritePos      = 0; // end of the written data
+    std::atomic<u64>             m_nReservedPos   = 0; // end of the data being written
+    verbosity                    m_eDumpVerbosity = verbosity::error;
+    log_rate_limiter             m_DumpLimiter;
+    std::filesystem::path        m_DumpPath;
+};
+
+} // namespace qx
+
+#include <qx/logger/flight_recorder_logger_stream.inl>
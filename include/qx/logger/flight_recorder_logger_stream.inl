@@ -0,0 +1,165 @@
+/**
+
+    @file      flight_recorder_logger_stream.inl
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+
+namespace qx
+{
+
+inline flight_recorder_logger_stream::flight_recorder_logger_stream(
+    size_t                              nCapacity,
+    verbosity                           eDumpVerbosity,
+    string_view                         svDumpFileName,
+    std::chrono::steady_clock::duration dumpPeriod)
+    : base_logger_stream(false)
+    , m_pBuffer(std::make_unique_for_overwrite<char_type[]>(std::max<size_t>(nCapacity, 1)))
+    , m_nCapacity(std::max<size_t>(nCapacity, 1))
+    , m_eDumpVerbosity(eDumpVerbosity)
+    , m_DumpLimiter(1, dumpPeriod)
+{
+    // it's cheap to record everything
+    // the base class has already registered the default unit, and registration doesn't overwrite units
+    deregister_unit(k_svDefaultUnit);
+    register_unit(k_svDefaultUnit, { verbosity::very_verbose });
+
+    // the path is prepared beforehand as dumping must not allocate
+    string sDumpFile = svDumpFileName;
+    sDumpFile += QX_TEXT(".log");
+    m_DumpPath = std::filesystem::path(to_wstring(sDumpFile).c_str());
+}
+
+inline void flight_recorder_logger_stream::flush()
+{
+}
+
+inline void flight_recorder_logger_stream::do_log(
+    string_view                            svMessage,
+    const log_unit&                        logUnit,
+    const std::vector<logger_color_range>& colors,
+    verbosity                              eVerbosity)
+{
+    QX_PERF_SCOPE(CatLogger, "Log to the flight recorder");
+
+    // there is only one writer as base_logger_stream locks m_LoggerStreamMutex while logging
+    const u64 nWritePos = m_nWritePos.load(std::memory_order_relaxed);
+
+    // only the tail of a message longer than the whole buffer can be kept
+    if (svMessage.size() > m_nCapacity)
+        svMessage.remove_prefix(svMessage.size() - m_nCapacity);
+
+    // announce the overwritten range before overwriting, so that dumping can detect it
+    m_nReservedPos.store(nWritePos + svMessage.size(), std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const size_t nIndex     = static_cast<size_t>(nWritePos % m_nCapacity);
+    const size_t nFirstPart = std::min(svMessage.size(), m_nCapacity - nIndex);
+    std::copy_n(svMessage.data(), nFirstPart, m_pBuffer.get() + nIndex);
+    std::copy_n(svMessage.data() + nFirstPart, svMessage.size() - nFirstPart, m_pBuffer.get());
+
+    m_nWritePos.store(nWritePos + svMessage.size(), std::memory_order_release);
+
+    // a burst of errors would rewrite the file for every message, the first one has the most useful context
+    u64 nSuppressed = 0;
+    if (eVerbosity >= m_eDumpVerbosity && m_eDumpVerbosity != verbosity::none && m_DumpLimiter.try_acquire(nSuppressed))
+        dump();
+}
+
+inline bool flight_recorder_logger_stream::dump() const noexcept
+{
+#if QX_WIN
+    const int nFile =
+        _wopen(m_DumpPath.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+    const int nFile = open(m_DumpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+#endif
+
+    if (nFile < 0)
+        return false;
+
+    dump(nFile);
+
+#if QX_WIN
+    _close(nFile);
+#else
+    close(nFile);
+#endif
+
+    return true;
+}
+
+inline void flight_recorder_logger_stream::dump(int nFile) const noexcept
+{
+    constexpr size_t k_nChunkSize = 1024;
+
+    char_type szChunk[k_nChunkSize];
+    char      szUtf8[get_max_utf8_size<char_type>(k_nChunkSize)];
+
+    const u64 nEnd      = m_nWritePos.load(std::memory_order_acquire);
+    u64       nPos      = get_oldest_position(nEnd);
+    bool      bSkipLine = nPos > 0;
+
+    while (nPos < nEnd)
+    {
+        const size_t nIndex = static_cast<size_t>(nPos % m_nCapacity);
+        const size_t nChunkSize =
+            static_cast<size_t>(std::min<u64>({ nEnd - nPos, k_nChunkSize, m_nCapacity - nIndex }));
+        std::copy_n(m_pBuffer.get() + nIndex, nChunkSize, szChunk);
+
+        // the chunk might be overwritten while copying, start again from the oldest message in this case
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const u64 nOldestPos = get_oldest_position(m_nReservedPos.load(std::memory_order_relaxed));
+        if (nOldestPos > nPos)
+        {
+            nPos      = nOldestPos;
+            bSkipLine = true;
+            continue;
+        }
+
+        string_view svChunk(szChunk, nChunkSize);
+        nPos += nChunkSize;
+
+        // the oldest message is usually partially overwritten
+        if (bSkipLine)
+        {
+            const size_t nLineEnd = svChunk.find(QX_TEXT('\n'));
+            if (nLineEnd == string_view::npos)
+                continue;
+
+            svChunk.remove_prefix(nLineEnd + 1);
+            bSkipLine = false;
+        }
+
+        const size_t nUtf8Size = encode_utf8(svChunk, szUtf8);
+#if QX_WIN
+        _write(nFile, szUtf8, static_cast<unsigned int>(nUtf8Size));
+#else
+        for (size_t nWritten = 0; nWritten < nUtf8Size;)
+        {
+            const ssize_t nResult = write(nFile, szUtf8 + nWritten, nUtf8Size - nWritten);
+            if (nResult < 0 && errno == EINTR)
+                continue;
+
+            if (nResult <= 0)
+                return;
+
+            nWritten += static_cast<size_t>(nResult);
+        }
+#endif
+    }
+}
+
+inline size_t flight_recorder_logger_stream::capacity() const noexcept
+{
+    return m_nCapacity;
+}
+
+inline u64 flight_recorder_logger_stream::get_oldest_position(u64 nEnd) const noexcept
+{
+    return nEnd > m_nCapacity ? nEnd - m_nCapacity : 0;
+}
+
+} // namespace qx
@@ -0,0 +1,95 @@
+/**
+
+    @file      log_rate_limit.h
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+#pragma once
+
+#include <qx/macros/copyable_movable.h>
+#include <qx/typedefs.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+namespace qx
+{
+
+/**
+
+    @class   log_sampler
+    @brief   Call site sampler: accepts the first N calls, then every Mth call
+    @details The decision costs one relaxed atomic increment
+    @author  Khrapov
+    @date    17.10.2026
+
+**/
+class log_sampler
+{
+public:
+    QX_NONCOPYMOVABLE(log_sampler);
+
+    /**
+        @brief log_sampler object constructor
+        @param nFirst - number of first calls to accept
+        @param nEvery - after the first calls accept every nEvery call, 0 to accept nothing
+    **/
+    constexpr log_sampler(u64 nFirst, u64 nEvery) noexcept;
+
+    /**
+        @brief  Decide if the call must be logged
+        @param  nSuppressed - number of calls suppressed since the previous accepted one, set only on acceptance
+        @retval             - true if the call must be logged
+    **/
+    bool try_acquire(u64& nSuppressed) noexcept;
+
+private:
+    std::atomic<u64> m_nCalls = 0;
+    u64              m_nFirst = 0;
+    u64              m_nEvery = 0;
+};
+
+/**
+
+    @class   log_rate_limiter
+    @brief   Call site rate limiter: accepts at most N calls per period
+    @details Token bucket implemented as a generic cell rate algorithm: the whole state is one atomic time point,
+             so the decision costs a clock read and one compare exchange without any locks
+    @author  Khrapov
+    @date    17.10.2026
+
+**/
+class log_rate_limiter
+{
+    using clock = std::chrono::steady_clock;
+
+public:
+    QX_NONCOPYMOVABLE(log_rate_limiter);
+
+    /**
+        @brief log_rate_limiter object constructor
+        @param nMessages - max number of calls per period, also the max burst size
+        @param period    - period duration
+    **/
+    log_rate_limiter(u64 nMessages, clock::duration period) noexcept;
+
+    /**
+        @brief  Decide if the call must be logged
+        @param  nSuppressed - number of calls suppressed since the previous accepted one, set only on acceptance
+        @retval             - true if the call must be logged
+    **/
+    bool try_acquire(u64& nSuppressed) noexcept;
+
+private:
+    clock::rep              m_nInterval = 0;
+    clock::rep              m_nPeriod   = 0;
+    std::atomic<clock::rep> m_nNextArrivalTime;
+    std::atomic<u64>        m_nSuppressed = 0;
+};
+
+} // namespace qx
+
+#include <qx/logger/log_rate_limit.inl>
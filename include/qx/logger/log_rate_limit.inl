@@ -0,0 +1,63 @@
+/**
+
+    @file      log_rate_limit.inl
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+
+namespace qx
+{
+
+constexpr log_sampler::log_sampler(u64 nFirst, u64 nEvery) noexcept : m_nFirst(nFirst), m_nEvery(nEvery)
+{
+}
+
+inline bool log_sampler::try_acquire(u64& nSuppressed) noexcept
+{
+    const u64 nCall = m_nCalls.fetch_add(1, std::memory_order_relaxed);
+    if (nCall < m_nFirst)
+    {
+        nSuppressed = 0;
+        return true;
+    }
+
+    if (m_nEvery == 0 || (nCall - m_nFirst + 1) % m_nEvery != 0)
+        return false;
+
+    nSuppressed = m_nEvery - 1;
+    return true;
+}
+
+inline log_rate_limiter::log_rate_limiter(u64 nMessages, clock::duration period) noexcept
+    : m_nInterval(period.count() / static_cast<clock::rep>(std::max<u64>(nMessages, 1)))
+    , m_nPeriod(period.count())
+    , m_nNextArrivalTime(clock::now().time_since_epoch().count())
+{
+}
+
+inline bool log_rate_limiter::try_acquire(u64& nSuppressed) noexcept
+{
+    const clock::rep nNow = clock::now().time_since_epoch().count();
+
+    clock::rep nArrivalTime = m_nNextArrivalTime.load(std::memory_order_relaxed);
+    while (true)
+    {
+        // every accepted call moves the arrival time by the interval, the bucket is empty if it's a period ahead
+        const clock::rep nNextArrivalTime = std::max(nArrivalTime, nNow) + m_nInterval;
+        if (nNextArrivalTime - nNow > m_nPeriod)
+        {
+            m_nSuppressed.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        if (m_nNextArrivalTime.compare_exchange_weak(nArrivalTime, nNextArrivalTime, std::memory_order_relaxed))
+            break;
+    }
+
+    nSuppressed = m_nSuppressed.exchange(0, std::memory_order_relaxed);
+    return true;
+}
+
+} // namespace qx
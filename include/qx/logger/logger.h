@@ -8,25 +8,58 @@
 **/
 #pragma once
 
+#include <qx/containers/mpmc_bounded_queue.h>
 #include <qx/logger/base_logger_stream.h>
+#include <qx/logger/binary_log.h>
+#include <qx/logger/log_rate_limit.h>
 #include <qx/patterns/singleton.h>
 
+#include <array>
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
 
 #ifndef QX_LOGGER_INSTANCE
     #define QX_LOGGER_INSTANCE qx::logger_singleton::get_instance()
 #endif
 
 /**
-    @brief Log with category
-    @param category   - category to be used to manage output
-    @param eVerbosity - message verbosity
-    @param format     - format string
-    @param ...        - additional args for formatting
+    @brief  Get log units cache of the call site for the current thread
+    @retval - log units cache reference
 **/
-#define QX_LOG_C(category, eVerbosity, format, ...) \
-    QX_LOGGER_INSTANCE                              \
-        .log(eVerbosity, format, category, QX_SHORT_FILE, qx::to_string(__FUNCTION__), QX_LINE, ##__VA_ARGS__)
+#define _QX_LOG_UNIT_CACHE()                       \
+    []() -> qx::log_unit_cache&                    \
+    {                                              \
+        thread_local qx::log_unit_cache unitCache; \
+        return unitCache;                          \
+    }()
+
+/**
+    @brief   Log with category
+    @details Category and verbosity must be constant expressions.
+             If message verbosity is lower than category verbosity, the call is discarded at compile time:
+             arguments are not evaluated and no strings are constructed.
+             The macro is a single expression, so it is safe in unbraced if/else
+    @param   category   - category to be used to manage output
+    @param   eVerbosity - message verbosity
+    @param   format     - format string
+    @param   ...        - additional args for formatting
+**/
+#define QX_LOG_C(category, eVerbosity, format, ...)                      \
+    (std::bool_constant<((eVerbosity) < (category).get_verbosity())>::value \
+         ? void()                                                           \
+         : QX_LOGGER_INSTANCE.log(                                          \
+               _QX_LOG_UNIT_CACHE(),                                        \
+               eVerbosity,                                                  \
+               format,                                                      \
+               category,                                                    \
+               QX_SHORT_FILE,                                               \
+               QX_FUNCTION_NAME,                                            \
+               QX_LINE,                                                     \
+               ##__VA_ARGS__))
 
 /**
     @def   QX_LOG
@@ -37,12 +70,178 @@
 **/
 #define QX_LOG(eVerbosity, format, ...) QX_LOG_C(CatDefault, eVerbosity, format, ##__VA_ARGS__)
 
+/**
+    @brief   Log with category in binary form
+    @details Call site info is created once, every call copies only raw args to the thread buffer.
+             Args are formatted later by the async logger worker thread.
+             Only arithmetic and string args are accepted.
+             If logger is not in async mode, the message is formatted immediately as in QX_LOG_C.
+             In async mode text and binary messages of the same thread may be written out of order,
+             see logger::enable_async()
+    @param   category   - category to be used to manage output
+    @param   eVerbosity - message verbosity
+    @param   format     - format string
+    @param   ...        - additional args for formatting
+**/
+#define QX_LOG_BINARY_C(category, eVerbosity, format, ...)                                 \
+    (std::bool_constant<((eVerbosity) < (category).get_verbosity())>::value                \
+         ? void()                                                                          \
+         : QX_LOGGER_INSTANCE.log_binary(                                                  \
+               _QX_LOG_UNIT_CACHE(),                                                       \
+               [&](qx::string_view svFunction) -> const qx::log_call_site&                 \
+               {                                                                           \
+                   static const qx::log_call_site callSite {                               \
+                       eVerbosity, category, QX_SHORT_FILE, svFunction, QX_LINE, format }; \
+                   return callSite;                                                        \
+               }(QX_FUNCTION_NAME),                                                        \
+               format,                                                                     \
+               ##__VA_ARGS__))
+
+/**
+    @def   QX_LOG_BINARY
+    @brief Log message in binary form
+    @param eVerbosity - message verbosity
+    @param format     - format string
+    @param ...        - additional args for formatting
+**/
+#define QX_LOG_BINARY(eVerbosity, format, ...) QX_LOG_BINARY_C(CatDefault, eVerbosity, format, ##__VA_ARGS__)
+
+/**
+    @brief   Log with category only if the call site limiter accepts the call
+    @details The limiter is checked before formatting. If calls were suppressed since the previous logged one,
+             their number is logged first
+    @param   limiter    - call site limiter expression, log_sampler or log_rate_limiter
+    @param   category   - category to be used to manage output
+    @param   eVerbosity - message verbosity
+    @param   format     - format string
+    @param   ...        - additional args for formatting
+**/
+#define _QX_LOG_C_LIMITED(limiter, category, eVerbosity, format, ...)       \
+    (std::bool_constant<((eVerbosity) < (category).get_verbosity())>::value \
+         ? void()                                                           \
+         : [&](qx::log_unit_cache& qxUnitCache, qx::string_view qxFunction) \
+           {                                                                \
+               if (QX_LOGGER_INSTANCE                                       \
+                       .check_rate_limit(                                   \
+                           qxUnitCache,                                     \
+                           limiter,                                         \
+                           eVerbosity,                                      \
+                           category,                                        \
+                           QX_SHORT_FILE,                                   \
+                           qxFunction,                                      \
+                           QX_LINE))                                        \
+               {                                                            \
+                   QX_LOGGER_INSTANCE.log(                                  \
+                       qxUnitCache,                                         \
+                       eVerbosity,                                          \
+                       format,                                              \
+                       category,                                            \
+                       QX_SHORT_FILE,                                       \
+                       qxFunction,                                          \
+                       QX_LINE,                                             \
+                       ##__VA_ARGS__);                                      \
+               }                                                            \
+           }(_QX_LOG_UNIT_CACHE(), QX_FUNCTION_NAME))
+
+/**
+    @brief   Log with category the first nFirst calls of the call site and then every nEvery call
+    @details Call site state is shared between threads. nFirst and nEvery must be constant expressions
+    @param   category   - category to be used to manage output
+    @param   eVerbosity - message verbosity
+    @param   nFirst     - number of first calls to log
+    @param   nEvery     - log every nEvery call after the first ones
+    @param   format     - format string
+    @param   ...        - additional args for formatting
+**/
+#define QX_LOG_C_SAMPLED(category, eVerbosity, nFirst, nEvery, format, ...) \
+    _QX_LOG_C_LIMITED(                                                     \
+        []() -> qx::log_sampler&                                           \
+        {                                                                  \
+            static qx::log_sampler sampler(nFirst, nEvery);                \
+            return sampler;                                                \
+        }(),                                                               \
+        category,                                                          \
+        eVerbosity,                                                        \
+        format,                                                            \
+        ##__VA_ARGS__)
+
+/**
+    @def   QX_LOG_SAMPLED
+    @brief Log the first nFirst calls of the call site and then every nEvery call
+    @param eVerbosity - message verbosity
+    @param nFirst     - number of first calls to log
+    @param nEvery     - log every nEvery call after the first ones
+    @param format     - format string
+    @param ...        - additional args for formatting
+**/
+#define QX_LOG_SAMPLED(eVerbosity, nFirst, nEvery, format, ...) \
+    QX_LOG_C_SAMPLED(CatDefault, eVerbosity, nFirst, nEvery, format, ##__VA_ARGS__)
+
+/**
+    @brief   Log with category at most nMessages calls of the call site per period
+    @details Call site state is shared between threads. nMessages and period must be constant expressions
+    @param   category   - category to be used to manage output
+    @param   eVerbosity - message verbosity
+    @param   nMessages  - max number of messages per period, also the max burst size
+    @param   period     - std::chrono duration
+    @param   format     - format string
+    @param   ...        - additional args for formatting
+**/
+#define QX_LOG_C_RATE_LIMITED(category, eVerbosity, nMessages, period, format, ...) \
+    _QX_LOG_C_LIMITED(                                                             \
+        []() -> qx::log_rate_limiter&                                              \
+        {                                                                          \
+            static qx::log_rate_limiter limiter(nMessages, period);                \
+            return limiter;                                                        \
+        }(),                                                                       \
+        category,                                                                  \
+        eVerbosity,                                                                \
+        format,                                                                    \
+        ##__VA_ARGS__)
+
+/**
+    @def   QX_LOG_RATE_LIMITED
+    @brief Log at most nMessages calls of the call site per period
+    @param eVerbosity - message verbosity
+    @param nMessages  - max number of messages per period, also the max burst size
+    @param period     - std::chrono duration
+    @param format     - format string
+    @param ...        - additional args for formatting
+**/
+#define QX_LOG_RATE_LIMITED(eVerbosity, nMessages, period, format, ...) \
+    QX_LOG_C_RATE_LIMITED(CatDefault, eVerbosity, nMessages, period, format, ##__VA_ARGS__)
+
 namespace qx
 {
 
 template<class... args_t>
 concept log_acceptable_args = (sizeof...(args_t) > 0 && format_acceptable_args<char_type, args_t...>);
 
+enum class log_queue_overflow_policy
+{
+    block,       //!< wait until the worker thread frees some space
+    drop_newest, //!< discard the message being logged
+    drop_oldest, //!< discard the oldest message in the queue
+};
+
+class logger;
+
+using log_stream_list = std::vector<base_logger_stream*>;
+
+/**
+    @struct log_unit_cache
+    @brief  Log units of all logger streams resolved for one call site
+            Log macros keep one cache per call site and thread, so steady state logging does no hashing
+**/
+struct log_unit_cache
+{
+    const logger*                        pLogger      = nullptr;
+    const log_stream_list*               pStreams     = nullptr; // streams the units were resolved for
+    u64                                  nGeneration  = 0;
+    bool                                 bAnyAccepted = false;
+    std::vector<std::optional<log_unit>> units; // one per logger stream
+};
+
 /**
 
     @class   logger
@@ -53,7 +252,56 @@ concept log_acceptable_args = (sizeof...(args_t) > 0 && format_acceptable_args<c
 **/
 class logger
 {
+    struct log_record
+    {
+        verbosity eVerbosity         = verbosity::log;
+        verbosity eCategoryVerbosity = verbosity::log;
+        color     categoryColor      = color::white();
+        int       nLine              = 0;
+        size_t    nCategorySize      = 0;
+        size_t    nFileSize          = 0;
+        size_t    nFunctionSize      = 0;
+
+        // category name, file, function and message one after another
+        // one string to make one allocation which is reused by the queue cells
+        string sData;
+    };
+
+    struct async_state
+    {
+        async_state(size_t nQueueCapacity, log_queue_overflow_policy eOverflowPolicy, size_t nBinaryBufferSize);
+
+        u64                            nId = 0;
+        mpmc_bounded_queue<log_record> queue;
+        log_queue_overflow_policy      eOverflowPolicy   = log_queue_overflow_policy::block;
+        size_t                         nBinaryBufferSize = 0;
+        std::thread                    worker;
+
+        // buffers of threads which used binary logging, a buffer is removed when its thread is finished
+        std::mutex                                               binaryBuffersMutex;
+        std::vector<std::shared_ptr<details::binary_log_buffer>> binaryBuffers;
+
+        // worker only
+        log_record                                               workerRecord;
+        std::vector<std::shared_ptr<details::binary_log_buffer>> workerBinaryBuffers;
+        string                                                   sBinaryMessage;
+
+        std::atomic<u32>  nSignal          = 0;
+        std::atomic<u64>  nFlushRequested  = 0;
+        std::atomic<u64>  nFlushCompleted  = 0;
+        std::atomic<u64>  nDroppedMessages = 0;
+        std::atomic<bool> bStop            = false;
+    };
+
+    // lines with the default format rendered for the current record, one per time precision
+    using shared_lines = std::array<const logger_buffer*, static_cast<size_t>(log_time_precision::microseconds) + 1>;
+
 public:
+    logger() noexcept = default;
+    QX_NONCOPYMOVABLE(logger);
+
+    ~logger() noexcept;
+
     /**
         @brief  Log to all streams
         @param  eVerbosity - message verbosity
@@ -71,6 +319,25 @@ public:
         string_view     svFunction,
         int             nLine);
 
+    /**
+        @brief  Log to all streams using call site log units cache
+        @param  unitCache  - log units cache, the rest of args except nLine must be the same for every call with it
+        @param  eVerbosity - message verbosity
+        @param  svFormat   - format string
+        @param  category   - code category
+        @param  svFile     - file name string
+        @param  svFunction - function name string
+        @param  nLine      - code line number
+    **/
+    void log(
+        log_unit_cache& unitCache,
+        verbosity       eVerbosity,
+        string_view     svFormat,
+        const category& category,
+        string_view     svFile,
+        string_view     svFunction,
+        int             nLine);
+
     /**
         @brief  Log to all streams
         @tparam args_t     - template parameter pack type
@@ -94,25 +361,131 @@ public:
         args_t&&... args);
 
     /**
-        @brief Flush all streams
+        @brief  Log to all streams using call site log units cache
+        @tparam args_t     - template parameter pack type
+        @param  unitCache  - log units cache, the rest of args except nLine must be the same for every call with it
+        @param  eVerbosity - message verbosity
+        @param  sFormat    - format string
+        @param  category   - code category
+        @param  svFile     - file name string
+        @param  svFunction - function name string
+        @param  nLine      - code line number
+        @param  args       - additional args for format
+    **/
+    template<class... args_t>
+        requires(log_acceptable_args<args_t...>)
+    void log(
+        log_unit_cache&                        unitCache,
+        verbosity                              eVerbosity,
+        format_string_strong_checks<args_t...> sFormat,
+        const category&                        category,
+        string_view                            svFile,
+        string_view                            svFunction,
+        int                                    nLine,
+        args_t&&... args);
+
+    /**
+        @brief   Log to all streams in binary form
+        @details Use QX_LOG_BINARY_C instead of calling this method directly
+        @tparam  args_t     - template parameter pack type
+        @param   unitCache  - log units cache of the call site
+        @param   callSite   - static call site info, must outlive the logger
+        @param   sFormat    - format string, must be the same as in the call site info
+        @param   args       - additional args for format
+    **/
+    template<class... args_t>
+        requires(binary_log_acceptable_args<args_t...>)
+    void log_binary(
+        log_unit_cache&                        unitCache,
+        const log_call_site&                   callSite,
+        format_string_strong_checks<args_t...> sFormat,
+        args_t&&... args);
+
+    /**
+        @brief   Check call site limiter and log the number of suppressed calls if needed
+        @details Use QX_LOG_C_SAMPLED or QX_LOG_C_RATE_LIMITED instead of calling this method directly
+        @tparam  limiter_t  - limiter type, log_sampler or log_rate_limiter
+        @param   unitCache  - log units cache of the call site
+        @param   limiter    - call site limiter
+        @param   eVerbosity - message verbosity
+        @param   category   - code category
+        @param   svFile     - file name string
+        @param   svFunction - function name string
+        @param   nLine      - code line number
+        @retval             - true if the call must be logged
+    **/
+    template<class limiter_t>
+    bool check_rate_limit(
+        log_unit_cache& unitCache,
+        limiter_t&      limiter,
+        verbosity       eVerbosity,
+        const category& category,
+        string_view     svFile,
+        string_view     svFunction,
+        int             nLine);
+
+    /**
+        @brief   Flush all streams
+        @details In async mode waits until all messages logged before this call are written and flushed
     **/
     void flush();
 
     /**
-        @brief Add output stream to the logger
-        @param pStream - stream unique pointer
+        @brief   Switch logger to async mode
+        @details Messages are formatted on the caller thread and pushed to the bounded lock-free queue,
+                 a dedicated worker thread writes them to the streams.
+                 Binary messages are written to per thread buffers and formatted by the worker thread.
+                 Binary buffers have a single consumer, so drop_oldest policy works as drop_newest for them.
+                 Binary messages bigger than half of the binary buffer are always dropped.
+                 The worker writes all queued text messages before binary ones, so text and binary messages
+                 of the same thread may be reordered.
+                 Must not be called concurrently with logging
+        @param   nQueueCapacity    - max number of messages waiting to be written
+        @param   eOverflowPolicy   - what to do when the queue or a binary buffer is full
+        @param   nBinaryBufferSize - size of a per thread binary buffer in bytes
+    **/
+    void enable_async(
+        size_t                    nQueueCapacity    = 8192,
+        log_queue_overflow_policy eOverflowPolicy   = log_queue_overflow_policy::block,
+        size_t                    nBinaryBufferSize = 64 * 1024);
+
+    /**
+        @brief   Write all queued messages, stop the worker thread and switch logger to sync mode
+        @details Must not be called concurrently with logging
+    **/
+    void disable_async() noexcept;
+
+    /**
+        @brief  Is logger in async mode
+        @retval  - true if logger is in async mode
+    **/
+    bool is_async() const noexcept;
+
+    /**
+        @brief  Get number of messages dropped because of the queue overflow
+        @retval  - number of messages dropped since enable_async() call
+    **/
+    u64 get_dropped_messages_count() const noexcept;
+
+    /**
+        @brief   Add output stream to the logger
+        @details Safe to call while other threads are logging: they see either the old or the new streams.
+                 Waits for the messages being output at the moment of the call,
+                 so calling it while outputting a message (e.g. from do_log() of a stream) deadlocks
+        @param   pStream - stream unique pointer
     **/
     void add_stream(std::unique_ptr<base_logger_stream> pStream) noexcept;
 
     /**
-        @brief Reset logger and clear all streams
+        @brief   Reset logger and clear all streams
+        @details Streams are destroyed after the messages being output at the moment of the call,
+                 so calling it while outputting a message (e.g. from do_log() of a stream) deadlocks
     **/
     void reset() noexcept;
 
     /**
         @brief   Returns true if any of streams will accept this message
-        @details Typically you don't want to use it
-                 It may be useful with async logging to avoid unnecessary formatting and queueing
+        @details Useful to skip preparing a message which no stream will accept
         @param   category   - code category
         @param   eVerbosity - message verbosity
         @param   svFile     - file name string
@@ -126,7 +499,193 @@ public:
         string_view     svFunction) const noexcept;
 
 private:
-    std::vector<std::unique_ptr<base_logger_stream>> m_Streams;
+    /**
+        @brief  Get log units cache for calls without a call site cache
+        @retval  - log units cache which will be resolved again
+    **/
+    static log_unit_cache& get_uncached_unit_cache() noexcept;
+
+    /**
+        @brief  Get buffers of the current thread for the line shared by streams with the default format
+        @param  eTimePrecision - time precision of the line
+        @retval                - string buffers
+    **/
+    static logger_buffer& get_shared_line_buffer(log_time_precision eTimePrecision) noexcept;
+
+    /**
+        @brief  Get current streams snapshot
+        @retval  - streams snapshot, valid until rcu_read_guard of the caller is destroyed, may be nullptr
+    **/
+    const log_stream_list* get_stream_list() const noexcept;
+
+    /**
+        @brief Publish new streams snapshot and delete the old one when no thread can read it
+        @param pStreamList - new streams snapshot
+    **/
+    void replace_stream_list(std::unique_ptr<log_stream_list> pStreamList) noexcept;
+
+    /**
+        @brief  Check if the call site cache is valid and rejects the message
+        @param  unitCache - log units cache
+        @retval           - true if no stream will accept the message
+    **/
+    bool is_rejected_by_cache(const log_unit_cache& unitCache) const noexcept;
+
+    /**
+        @brief Flush all streams
+    **/
+    void flush_streams();
+
+    /**
+        @brief  Resolve log units of all streams if the cache is outdated
+        @param  unitCache  - log units cache
+        @param  category   - code category
+        @param  eVerbosity - message verbosity
+        @param  svFile     - file name string
+        @param  svFunction - function name string
+        @retval            - resolved log units cache
+    **/
+    const log_unit_cache& resolve_units(
+        log_unit_cache& unitCache,
+        const category& category,
+        verbosity       eVerbosity,
+        string_view     svFile,
+        string_view     svFunction) const noexcept;
+
+    /**
+        @brief Output a message to all streams with resolved log units
+        @param unitCache  - resolved log units cache
+        @param eVerbosity - message verbosity
+        @param category   - code category
+        @param svFile     - file name string
+        @param svFunction - function name string
+        @param nLine      - code line number
+        @param svMessage  - formatted message
+    **/
+    void output(
+        const log_unit_cache& unitCache,
+        verbosity             eVerbosity,
+        const category&       category,
+        string_view           svFile,
+        string_view           svFunction,
+        int                   nLine,
+        string_view           svMessage);
+
+    /**
+        @brief Output a message to all streams
+        @param eVerbosity - message verbosity
+        @param category   - code category
+        @param svFile     - file name string
+        @param svFunction - function name string
+        @param nLine      - code line number
+        @param svMessage  - formatted message
+    **/
+    void output(
+        verbosity       eVerbosity,
+        const category& category,
+        string_view     svFile,
+        string_view     svFunction,
+        int             nLine,
+        string_view     svMessage);
+
+    /**
+        @brief   Output a message to a stream
+        @details Lines with the default format are rendered once per record and time precision
+                 and then shared by all streams which use this format
+        @param   stream      - logger stream
+        @param   logUnit     - log unit of this stream
+        @param   sharedLines - lines of this record rendered for the previous streams
+        @param   eVerbosity  - message verbosity
+        @param   category    - code category
+        @param   svFile      - file name string
+        @param   svFunction  - function name string
+        @param   nLine       - code line number
+        @param   svMessage   - formatted message
+    **/
+    void output_to_stream(
+        base_logger_stream& stream,
+        const log_unit&     logUnit,
+        shared_lines&       sharedLines,
+        verbosity           eVerbosity,
+        const category&     category,
+        string_view         svFile,
+        string_view         svFunction,
+        int                 nLine,
+        string_view         svMessage);
+
+    /**
+        @brief  Push a message to the async queue
+        @tparam append_message_func_t - function type, void(string&)
+        @param  eVerbosity            - message verbosity
+        @param  category              - code category
+        @param  svFile                - file name string
+        @param  svFunction            - function name string
+        @param  nLine                 - code line number
+        @param  appendMessageFunc     - function appending the message to the record string
+    **/
+    template<class append_message_func_t>
+    void push_record(
+        verbosity               eVerbosity,
+        const category&         category,
+        string_view             svFile,
+        string_view             svFunction,
+        int                     nLine,
+        append_message_func_t&& appendMessageFunc);
+
+    /**
+        @brief  Push a binary record to the current thread buffer
+        @tparam write_record_func_t - function type, void(std::byte*)
+        @param  nRecordSize         - record size in bytes
+        @param  writeRecordFunc     - function writing the record
+    **/
+    template<class write_record_func_t>
+    void push_binary_record(size_t nRecordSize, write_record_func_t&& writeRecordFunc);
+
+    /**
+        @brief  Get binary buffer of the current thread, create it if there is none
+        @retval  - binary buffer of the current thread
+    **/
+    details::binary_log_buffer& get_thread_binary_log_buffer();
+
+    /**
+        @brief  Should the message be written synchronously
+        @retval  - true if logger is not in async mode or the caller is the worker thread
+    **/
+    bool is_sync_output() const noexcept;
+
+    /**
+        @brief Wake up the worker thread
+    **/
+    void notify_worker() noexcept;
+
+    /**
+        @brief Worker thread function
+    **/
+    void worker_loop();
+
+    /**
+        @brief Output a queued record to all streams
+        @param record - queued record
+    **/
+    void output_record(const log_record& record);
+
+    /**
+        @brief  Output all records of all binary buffers
+        @retval  - true if there was at least one record
+    **/
+    bool drain_binary_buffers();
+
+    /**
+        @brief Decode a binary record and output it to all streams
+        @param pRecord - binary record
+    **/
+    void output_binary_record(const std::byte* pRecord);
+
+private:
+    std::mutex                                       m_StreamsMutex; // serializes streams changes
+    std::vector<std::unique_ptr<base_logger_stream>> m_Streams;      // owns streams, readers use the snapshot
+    std::atomic<const log_stream_list*>              m_pStreamList = nullptr;
+    std::unique_ptr<async_state>                     m_pAsyncState;
 };
 
 /**
@@ -10,7 +10,39 @@
 namespace qx
 {
 
+inline logger::async_state::async_state(
+    size_t                    nQueueCapacity,
+    log_queue_overflow_policy eOverflowPolicy,
+    size_t                    nBinaryBufferSize)
+    : queue(nQueueCapacity)
+    , eOverflowPolicy(eOverflowPolicy)
+    , nBinaryBufferSize(nBinaryBufferSize)
+{
+    // thread binary buffers are bound to the state by id, ids are never reused
+    static std::atomic<u64> nLastId = 0;
+    nId                             = nLastId.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+inline logger::~logger() noexcept
+{
+    disable_async();
+    delete m_pStreamList.load(std::memory_order_relaxed);
+    base_logger_stream::increment_units_generation();
+}
+
+inline void logger::log(
+    verbosity       eVerbosity,
+    string_view     svFormat,
+    const category& category,
+    string_view     svFile,
+    string_view     svFunction,
+    int             nLine)
+{
+    log(get_uncached_unit_cache(), eVerbosity, svFormat, category, svFile, svFunction, nLine);
+}
+
 inline void logger::log(
+    log_unit_cache& unitCache,
     verbosity       eVerbosity,
     string_view     svFormat,
     const category& category,
@@ -18,13 +50,59 @@ inline void logger::log(
     string_view     svFunction,
     int             nLine)
 {
-    for (const auto& stream : m_Streams)
-        stream->log(eVerbosity, category, svFile, svFunction, nLine, svFormat);
+    if (is_rejected_by_cache(unitCache))
+        return;
+
+    rcu_read_guard readGuard;
+
+    const auto& resolvedUnits = resolve_units(unitCache, category, eVerbosity, svFile, svFunction);
+    if (!resolvedUnits.bAnyAccepted)
+        return;
+
+    if (is_sync_output())
+    {
+        output(resolvedUnits, eVerbosity, category, svFile, svFunction, nLine, svFormat);
+    }
+    else
+    {
+        push_record(
+            eVerbosity,
+            category,
+            svFile,
+            svFunction,
+            nLine,
+            [svFormat](string& sData)
+            {
+                sData += svFormat;
+            });
+    }
+}
+
+template<class... args_t>
+    requires(log_acceptable_args<args_t...>)
+inline void logger::log(
+    verbosity                              eVerbosity,
+    format_string_strong_checks<args_t...> sFormat,
+    const category&                        category,
+    string_view                            svFile,
+    string_view                            svFunction,
+    int                                    nLine,
+    args_t&&... args)
+{
+    log(get_uncached_unit_cache(),
+        eVerbosity,
+        sFormat,
+        category,
+        svFile,
+        svFunction,
+        nLine,
+        std::forward<args_t>(args)...);
 }
 
 template<class... args_t>
     requires(log_acceptable_args<args_t...>)
 inline void logger::log(
+    log_unit_cache&                        unitCache,
     verbosity                              eVerbosity,
     format_string_strong_checks<args_t...> sFormat,
     const category&                        category,
@@ -33,24 +111,188 @@ inline void logger::log(
     int                                    nLine,
     args_t&&... args)
 {
-    const auto sLogMessage = qx::string::static_format(sFormat, std::forward<args_t>(args)...);
-    for (const auto& stream : m_Streams)
-        stream->log(eVerbosity, category, svFile, svFunction, nLine, sLogMessage);
+    if (is_rejected_by_cache(unitCache))
+        return;
+
+    rcu_read_guard readGuard;
+
+    // formatting is much more expensive than the check
+    const auto& resolvedUnits = resolve_units(unitCache, category, eVerbosity, svFile, svFunction);
+    if (!resolvedUnits.bAnyAccepted)
+        return;
+
+    if (is_sync_output())
+    {
+        const auto sLogMessage = qx::string::static_format(sFormat, std::forward<args_t>(args)...);
+        output(resolvedUnits, eVerbosity, category, svFile, svFunction, nLine, sLogMessage);
+    }
+    else
+    {
+        push_record(
+            eVerbosity,
+            category,
+            svFile,
+            svFunction,
+            nLine,
+            [&sFormat, &args...](string& sData)
+            {
+                sData.append_format(sFormat, std::forward<args_t>(args)...);
+            });
+    }
+}
+
+template<class... args_t>
+    requires(binary_log_acceptable_args<args_t...>)
+inline void logger::log_binary(
+    log_unit_cache&                        unitCache,
+    const log_call_site&                   callSite,
+    format_string_strong_checks<args_t...> sFormat,
+    args_t&&... args)
+{
+    if (is_rejected_by_cache(unitCache))
+        return;
+
+    rcu_read_guard readGuard;
+
+    const auto& resolvedUnits =
+        resolve_units(unitCache, callSite.logCategory, callSite.eVerbosity, callSite.svFile, callSite.svFunction);
+    if (!resolvedUnits.bAnyAccepted)
+        return;
+
+    if (is_sync_output())
+    {
+        const auto sLogMessage = qx::string::static_format(sFormat, std::forward<args_t>(args)...);
+        output(
+            resolvedUnits,
+            callSite.eVerbosity,
+            callSite.logCategory,
+            callSite.svFile,
+            callSite.svFunction,
+            callSite.nLine,
+            sLogMessage);
+    }
+    else
+    {
+        const size_t nRecordSize = details::get_binary_log_record_size(args...);
+        push_binary_record(
+            nRecordSize,
+            [nRecordSize, &callSite, &args...](std::byte* pRecord)
+            {
+                details::write_binary_log_record(pRecord, nRecordSize, callSite, args...);
+            });
+    }
+}
+
+template<class limiter_t>
+inline bool logger::check_rate_limit(
+    log_unit_cache& unitCache,
+    limiter_t&      limiter,
+    verbosity       eVerbosity,
+    const category& category,
+    string_view     svFile,
+    string_view     svFunction,
+    int             nLine)
+{
+    u64 nSuppressed = 0;
+    if (!limiter.try_acquire(nSuppressed))
+        return false;
+
+    if (nSuppressed > 0)
+    {
+        log(unitCache,
+            eVerbosity,
+            QX_TEXT("{} similar messages were suppressed"),
+            category,
+            svFile,
+            svFunction,
+            nLine,
+            nSuppressed);
+    }
+
+    return true;
 }
 
 inline void logger::flush()
 {
-    for (const auto& stream : m_Streams)
-        stream->flush();
+    if (is_sync_output())
+    {
+        flush_streams();
+        return;
+    }
+
+    // the worker thread drains the queue and flushes the streams when it sees a new request
+    const u64 nRequest = m_pAsyncState->nFlushRequested.fetch_add(1, std::memory_order_acq_rel) + 1;
+    notify_worker();
+
+    u64 nCompleted = m_pAsyncState->nFlushCompleted.load(std::memory_order_acquire);
+    while (nCompleted < nRequest)
+    {
+        m_pAsyncState->nFlushCompleted.wait(nCompleted, std::memory_order_acquire);
+        nCompleted = m_pAsyncState->nFlushCompleted.load(std::memory_order_acquire);
+    }
+}
+
+inline void logger::enable_async(
+    size_t                    nQueueCapacity,
+    log_queue_overflow_policy eOverflowPolicy,
+    size_t                    nBinaryBufferSize)
+{
+    disable_async();
+
+    m_pAsyncState         = std::make_unique<async_state>(nQueueCapacity, eOverflowPolicy, nBinaryBufferSize);
+    m_pAsyncState->worker = std::thread(
+        [this]()
+        {
+            worker_loop();
+        });
+}
+
+inline void logger::disable_async() noexcept
+{
+    if (!m_pAsyncState)
+        return;
+
+    m_pAsyncState->bStop.store(true, std::memory_order_release);
+    notify_worker();
+
+    if (m_pAsyncState->worker.joinable())
+        m_pAsyncState->worker.join();
+
+    m_pAsyncState.reset();
+}
+
+inline bool logger::is_async() const noexcept
+{
+    return m_pAsyncState != nullptr;
+}
+
+inline u64 logger::get_dropped_messages_count() const noexcept
+{
+    return m_pAsyncState ? m_pAsyncState->nDroppedMessages.load(std::memory_order_relaxed) : 0;
 }
 
 inline void logger::add_stream(std::unique_ptr<base_logger_stream> pStream) noexcept
 {
+    std::lock_guard lock(m_StreamsMutex);
+
+    auto pStreamList = std::make_unique<log_stream_list>();
+    if (const log_stream_list* pOldStreamList = get_stream_list())
+        *pStreamList = *pOldStreamList;
+
+    pStreamList->push_back(pStream.get());
     m_Streams.push_back(std::move(pStream));
+
+    replace_stream_list(std::move(pStreamList));
 }
 
 inline void logger::reset() noexcept
 {
+    disable_async();
+
+    std::lock_guard lock(m_StreamsMutex);
+
+    // no thread can see the streams after the snapshot is replaced
+    replace_stream_list(nullptr);
     m_Streams.clear();
 }
 
@@ -60,11 +302,446 @@ inline bool logger::will_any_stream_accept(
     string_view     svFile,
     string_view     svFunction) const noexcept
 {
-    for (const auto& stream : m_Streams)
-        if (stream->get_unit_info(category, eVerbosity, svFile, svFunction))
-            return true;
+    rcu_read_guard readGuard;
+
+    if (const log_stream_list* pStreamList = get_stream_list())
+    {
+        for (const base_logger_stream* pStream : *pStreamList)
+            if (pStream->get_unit_info(category, eVerbosity, svFile, svFunction))
+                return true;
+    }
 
     return false;
 }
 
+inline log_unit_cache& logger::get_uncached_unit_cache() noexcept
+{
+    thread_local log_unit_cache unitCache;
+    unitCache.pLogger = nullptr;
+    return unitCache;
+}
+
+inline logger_buffer& logger::get_shared_line_buffer(log_time_precision eTimePrecision) noexcept
+{
+    thread_local std::array<logger_buffer, std::tuple_size_v<shared_lines>> buffers;
+    return buffers[static_cast<size_t>(eTimePrecision)];
+}
+
+inline const log_stream_list* logger::get_stream_list() const noexcept
+{
+    return m_pStreamList.load(std::memory_order_acquire);
+}
+
+inline void logger::replace_stream_list(std::unique_ptr<log_stream_list> pStreamList) noexcept
+{
+    std::unique_ptr<const log_stream_list> pOldStreamList(
+        m_pStreamList.exchange(pStreamList.release(), std::memory_order_acq_rel));
+    base_logger_stream::increment_units_generation();
+    rcu_synchronize();
+}
+
+inline bool logger::is_rejected_by_cache(const log_unit_cache& unitCache) const noexcept
+{
+    // nothing is dereferenced here, so the check doesn't need a read section
+    return unitCache.pLogger == this && !unitCache.bAnyAccepted
+           && unitCache.nGeneration == base_logger_stream::get_units_generation()
+           && unitCache.pStreams == get_stream_list();
+}
+
+inline void logger::flush_streams()
+{
+    rcu_read_guard readGuard;
+
+    if (const log_stream_list* pStreamList = get_stream_list())
+    {
+        // the caller may be any thread while others are logging to the same streams
+        for (base_logger_stream* pStream : *pStreamList)
+            pStream->locked_flush();
+    }
+}
+
+inline const log_unit_cache& logger::resolve_units(
+    log_unit_cache& unitCache,
+    const category& category,
+    verbosity       eVerbosity,
+    string_view     svFile,
+    string_view     svFunction) const noexcept
+{
+    // streams and units are published before the generation is changed,
+    // so the generation is read first and the units are never older than it
+    const u64              nGeneration = base_logger_stream::get_units_generation();
+    const log_stream_list* pStreamList = get_stream_list();
+    if (unitCache.pLogger == this && unitCache.nGeneration == nGeneration && unitCache.pStreams == pStreamList)
+        return unitCache;
+
+    QX_PERF_SCOPE(CatLogger, "Resolve log units");
+
+    unitCache.units.resize(pStreamList ? pStreamList->size() : 0);
+    unitCache.bAnyAccepted = false;
+
+    for (size_t i = 0; i < unitCache.units.size(); ++i)
+    {
+        unitCache.units[i] = (*pStreamList)[i]->get_unit_info(category, eVerbosity, svFile, svFunction);
+        unitCache.bAnyAccepted |= unitCache.units[i].has_value();
+    }
+
+    unitCache.pLogger     = this;
+    unitCache.pStreams    = pStreamList;
+    unitCache.nGeneration = nGeneration;
+
+    return unitCache;
+}
+
+inline void logger::output(
+    const log_unit_cache& unitCache,
+    verbosity             eVerbosity,
+    const category&       category,
+    string_view           svFile,
+    string_view           svFunction,
+    int                   nLine,
+    string_view           svMessage)
+{
+    shared_lines sharedLines {};
+
+    // units are resolved in the same read section, so the snapshot is still alive
+    for (size_t i = 0; i < unitCache.units.size(); ++i)
+    {
+        if (const auto& optLogUnit = unitCache.units[i])
+        {
+            output_to_stream(
+                *(*unitCache.pStreams)[i],
+                *optLogUnit,
+                sharedLines,
+                eVerbosity,
+                category,
+                svFile,
+                svFunction,
+                nLine,
+                svMessage);
+        }
+    }
+}
+
+inline void logger::output(
+    verbosity       eVerbosity,
+    const category& category,
+    string_view     svFile,
+    string_view     svFunction,
+    int             nLine,
+    string_view     svMessage)
+{
+    rcu_read_guard readGuard;
+
+    const log_stream_list* pStreamList = get_stream_list();
+    if (!pStreamList)
+        return;
+
+    shared_lines sharedLines {};
+
+    for (base_logger_stream* pStream : *pStreamList)
+    {
+        if (const auto optLogUnit = pStream->get_unit_info(category, eVerbosity, svFile, svFunction))
+        {
+            output_to_stream(
+                *pStream,
+                *optLogUnit,
+                sharedLines,
+                eVerbosity,
+                category,
+                svFile,
+                svFunction,
+                nLine,
+                svMessage);
+        }
+    }
+}
+
+inline void logger::output_to_stream(
+    base_logger_stream& stream,
+    const log_unit&     logUnit,
+    shared_lines&       sharedLines,
+    verbosity           eVerbosity,
+    const category&     category,
+    string_view         svFile,
+    string_view         svFunction,
+    int                 nLine,
+    string_view         svMessage)
+{
+    if (!base_logger_stream::has_default_format(logUnit))
+    {
+        stream.log(logUnit, eVerbosity, category, svFile, svFunction, nLine, svMessage);
+        return;
+    }
+
+    const log_time_precision ePrecision  = stream.get_time_precision();
+    const logger_buffer*&    pSharedLine = sharedLines[static_cast<size_t>(ePrecision)];
+
+    // the line is rendered once per record and time precision whatever the streams order is
+    if (!pSharedLine)
+    {
+        QX_PERF_SCOPE(CatLogger, "Log formatting");
+
+        logger_buffer& sharedLine = get_shared_line_buffer(ePrecision);
+        sharedLine.clear();
+        base_logger_stream::format_line(
+            sharedLine,
+            eVerbosity,
+            category,
+            svFile,
+            svFunction,
+            nLine,
+            svMessage,
+            ePrecision);
+        pSharedLine = &sharedLine;
+    }
+
+    stream.log_formatted(logUnit, eVerbosity, *pSharedLine);
+}
+
+template<class append_message_func_t>
+inline void logger::push_record(
+    verbosity               eVerbosity,
+    const category&         category,
+    string_view             svFile,
+    string_view             svFunction,
+    int                     nLine,
+    append_message_func_t&& appendMessageFunc)
+{
+    QX_PERF_SCOPE(CatLogger, "Push log record");
+
+    auto fill_record = [&](log_record& record)
+    {
+        record.eVerbosity         = eVerbosity;
+        record.eCategoryVerbosity = category.get_verbosity();
+        record.categoryColor      = category.get_color();
+        record.nLine              = nLine;
+        record.nCategorySize      = category.get_name().size();
+        record.nFileSize          = svFile.size();
+        record.nFunctionSize      = svFunction.size();
+
+        record.sData.clear();
+        record.sData += category.get_name();
+        record.sData += svFile;
+        record.sData += svFunction;
+        appendMessageFunc(record.sData);
+    };
+
+    async_state& state = *m_pAsyncState;
+    while (!state.queue.try_push_with(fill_record))
+    {
+        switch (state.eOverflowPolicy)
+        {
+        case log_queue_overflow_policy::block:
+            notify_worker();
+            std::this_thread::yield();
+            break;
+
+        case log_queue_overflow_policy::drop_newest:
+            state.nDroppedMessages.fetch_add(1, std::memory_order_relaxed);
+            return;
+
+        case log_queue_overflow_policy::drop_oldest:
+            if (state.queue.try_pop_with(
+                    [](log_record&)
+                    {
+                    }))
+            {
+                state.nDroppedMessages.fetch_add(1, std::memory_order_relaxed);
+            }
+            break;
+        }
+    }
+
+    notify_worker();
+}
+
+template<class write_record_func_t>
+inline void logger::push_binary_record(size_t nRecordSize, write_record_func_t&& writeRecordFunc)
+{
+    QX_PERF_SCOPE(CatLogger, "Push binary log record");
+
+    async_state&                state  = *m_pAsyncState;
+    details::binary_log_buffer& buffer = get_thread_binary_log_buffer();
+
+    // a bigger record may never fit, waiting for it would block the thread forever
+    if (nRecordSize > buffer.max_record_size())
+    {
+        state.nDroppedMessages.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    std::byte* pRecord = buffer.try_reserve(nRecordSize);
+    while (!pRecord)
+    {
+        if (state.eOverflowPolicy != log_queue_overflow_policy::block)
+        {
+            state.nDroppedMessages.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        notify_worker();
+        std::this_thread::yield();
+        pRecord = buffer.try_reserve(nRecordSize);
+    }
+
+    writeRecordFunc(pRecord);
+    buffer.commit();
+
+    notify_worker();
+}
+
+inline details::binary_log_buffer& logger::get_thread_binary_log_buffer()
+{
+    struct thread_buffer
+    {
+        u64                                         nStateId = 0;
+        std::shared_ptr<details::binary_log_buffer> pBuffer;
+    };
+
+    // usually there is one logger, so this vector has one element
+    thread_local std::vector<thread_buffer> threadBuffers;
+
+    async_state& state = *m_pAsyncState;
+    for (const auto& threadBuffer : threadBuffers)
+    {
+        if (threadBuffer.nStateId == state.nId)
+            return *threadBuffer.pBuffer;
+    }
+
+    // buffers of destroyed async states are owned only by this thread
+    std::erase_if(
+        threadBuffers,
+        [](const thread_buffer& threadBuffer)
+        {
+            return threadBuffer.pBuffer.use_count() == 1;
+        });
+
+    auto pBuffer = std::make_shared<details::binary_log_buffer>(state.nBinaryBufferSize);
+    {
+        std::lock_guard lock(state.binaryBuffersMutex);
+        state.binaryBuffers.push_back(pBuffer);
+    }
+
+    threadBuffers.push_back({ state.nId, pBuffer });
+    return *pBuffer;
+}
+
+inline bool logger::is_sync_output() const noexcept
+{
+    // the worker thread may log too (e.g. from a stream), it must not wait for itself
+    return !m_pAsyncState || m_pAsyncState->worker.get_id() == std::this_thread::get_id();
+}
+
+inline void logger::notify_worker() noexcept
+{
+    m_pAsyncState->nSignal.fetch_add(1, std::memory_order_release);
+    m_pAsyncState->nSignal.notify_one();
+}
+
+inline void logger::worker_loop()
+{
+    async_state& state = *m_pAsyncState;
+
+    while (true)
+    {
+        // read everything before draining so that no request or message is missed before waiting
+        const u32  nSignal         = state.nSignal.load(std::memory_order_acquire);
+        const u64  nFlushRequested = state.nFlushRequested.load(std::memory_order_acquire);
+        const bool bStop           = state.bStop.load(std::memory_order_acquire);
+
+        do
+        {
+            // empty() also counts the records being pushed right now, wait for them to be completed
+            while (!state.queue.empty())
+            {
+                // take the record out of the cell before the output: a cell held by a slow stream
+                // blocks the ring for producers and drop_oldest would have nothing to evict
+                const bool bPopped = state.queue.try_pop_with(
+                    [&state](log_record& record)
+                    {
+                        std::swap(state.workerRecord, record);
+                    });
+
+                if (bPopped)
+                    output_record(state.workerRecord);
+                else
+                    std::this_thread::yield();
+            }
+        } while (drain_binary_buffers());
+
+        if (nFlushRequested != state.nFlushCompleted.load(std::memory_order_relaxed))
+        {
+            flush_streams();
+
+            state.nFlushCompleted.store(nFlushRequested, std::memory_order_release);
+            state.nFlushCompleted.notify_all();
+        }
+
+        if (bStop)
+            break;
+
+        state.nSignal.wait(nSignal, std::memory_order_acquire);
+    }
+}
+
+inline void logger::output_record(const log_record& record)
+{
+    const string_view svData = record.sData;
+
+    const auto svCategoryName = svData.substr(0, record.nCategorySize);
+    const auto svFile         = svData.substr(record.nCategorySize, record.nFileSize);
+    const auto svFunction     = svData.substr(record.nCategorySize + record.nFileSize, record.nFunctionSize);
+    const auto svMessage      = svData.substr(record.nCategorySize + record.nFileSize + record.nFunctionSize);
+
+    const category recordCategory =
+        category(svCategoryName, record.categoryColor).set_verbosity(record.eCategoryVerbosity);
+
+    output(record.eVerbosity, recordCategory, svFile, svFunction, record.nLine, svMessage);
+}
+
+inline bool logger::drain_binary_buffers()
+{
+    async_state& state = *m_pAsyncState;
+
+    {
+        std::lock_guard lock(state.binaryBuffersMutex);
+
+        // the buffer of a finished thread is owned only by the state
+        std::erase_if(
+            state.binaryBuffers,
+            [](const std::shared_ptr<details::binary_log_buffer>& pBuffer)
+            {
+                return pBuffer.use_count() == 1 && pBuffer->empty();
+            });
+
+        state.workerBinaryBuffers = state.binaryBuffers;
+    }
+
+    bool bConsumed = false;
+    for (const auto& pBuffer : state.workerBinaryBuffers)
+    {
+        bConsumed |= pBuffer->consume_all(
+            [this](const std::byte* pRecord)
+            {
+                output_binary_record(pRecord);
+            });
+    }
+
+    return bConsumed;
+}
+
+inline void logger::output_binary_record(const std::byte* pRecord)
+{
+    details::binary_log_record_header header;
+    std::memcpy(&header, pRecord, sizeof(header));
+
+    const log_call_site& callSite = *header.pCallSite;
+
+    string& sMessage = m_pAsyncState->sBinaryMessage;
+    sMessage.clear();
+    header.pDecodeFunc(callSite.svFormat, pRecord + sizeof(header), sMessage);
+
+    output(callSite.eVerbosity, callSite.logCategory, callSite.svFile, callSite.svFunction, callSite.nLine, sMessage);
+}
+
 } // namespace qx
@@ -10,8 +10,8 @@
 
 #include <qx/containers/string/string.h>
 #include <qx/render/color.h>
-#include <qx/static_buffer.h>
 
+#include <algorithm>
 #include <iostream>
 
 namespace qx
@@ -57,6 +57,27 @@ class terminal_color
         reset
     };
 
+public:
+    // "\033[38;2;255;255;255m" is the longest sequence
+    static constexpr size_t k_nMaxSequenceSize = 20;
+
+    /**
+        @struct sequence
+        @brief  Rendered escape sequence which doesn't need any allocations
+        @tparam char_t - char type
+    **/
+    template<class char_t>
+    struct sequence
+    {
+        char_t szData[k_nMaxSequenceSize] = {};
+        size_t nSize                      = 0;
+
+        constexpr std::basic_string_view<char_t> view() const noexcept
+        {
+            return { szData, nSize };
+        }
+    };
+
 public:
     /**
         @brief  Set font color
@@ -83,6 +104,15 @@ public:
     **/
     static void test_colors();
 
+    /**
+        @brief   Render escape sequence of this terminal color
+        @details Rendered sequences may be cached and written as is without any formatting
+        @tparam  char_t - char type
+        @retval         - escape sequence
+    **/
+    template<class char_t>
+    constexpr sequence<char_t> get_sequence() const noexcept;
+
 private:
     /**
         @brief terminal_color object constructor
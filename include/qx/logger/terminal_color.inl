@@ -10,32 +10,7 @@
 template<class char_t>
 std::basic_ostream<char_t>& operator<<(std::basic_ostream<char_t>& os, const qx::terminal_color& terminalColor)
 {
-    auto& sBuffer = qx::static_buffer::get_instance().get_buffer<qx::basic_string<char_t>>();
-
-    switch (terminalColor.m_eType)
-    {
-    case qx::terminal_color::type::font:
-        sBuffer.format(
-            QX_STR_PREFIX(char_t, "\033[38;2;{};{};{}m"),
-            terminalColor.m_Color.r_dec(),
-            terminalColor.m_Color.g_dec(),
-            terminalColor.m_Color.b_dec());
-        break;
-
-    case qx::terminal_color::type::back:
-        sBuffer.format(
-            QX_STR_PREFIX(char_t, "\033[48;2;{};{};{}m"),
-            terminalColor.m_Color.r_dec(),
-            terminalColor.m_Color.g_dec(),
-            terminalColor.m_Color.b_dec());
-        break;
-
-    case qx::terminal_color::type::reset:
-        sBuffer = QX_STR_PREFIX(char_t, "\033[0m");
-        break;
-    }
-
-    os << sBuffer;
+    os << terminalColor.get_sequence<char_t>().view();
     return os;
 }
 
@@ -65,6 +40,54 @@ constexpr terminal_color::terminal_color(type eType) noexcept : m_eType(eType)
 {
 }
 
+template<class char_t>
+constexpr terminal_color::sequence<char_t> terminal_color::get_sequence() const noexcept
+{
+    sequence<char_t> result;
+
+    auto append = [&result](char chSymbol)
+    {
+        result.szData[result.nSize++] = static_cast<char_t>(chSymbol);
+    };
+
+    auto append_component = [&append](int nValue)
+    {
+        nValue = std::clamp(nValue, 0, 255);
+
+        if (nValue >= 100)
+            append(static_cast<char>('0' + nValue / 100));
+
+        if (nValue >= 10)
+            append(static_cast<char>('0' + nValue / 10 % 10));
+
+        append(static_cast<char>('0' + nValue % 10));
+    };
+
+    append('\033');
+    append('[');
+
+    if (m_eType == type::reset)
+    {
+        append('0');
+    }
+    else
+    {
+        append(m_eType == type::font ? '3' : '4');
+        append('8');
+        append(';');
+        append('2');
+
+        for (const int nComponent : { m_Color.r_dec(), m_Color.g_dec(), m_Color.b_dec() })
+        {
+            append(';');
+            append_component(nComponent);
+        }
+    }
+
+    append('m');
+    return result;
+}
+
 inline void terminal_color::test_colors()
 {
     using namespace std;
@@ -11,6 +11,8 @@
 #include <qx/category.h>
 #include <qx/logger/logger.h>
 
+#include <atomic>
+#include <chrono>
 #include <exception>
 
 #if QX_MSVC
@@ -51,6 +53,9 @@ void resolve_assert_proceeding(
     // ... args
     const category& category)
 {
+    if (!QX_LOGGER_INSTANCE.will_any_stream_accept(category, eVerbosity, svFile, svFunction))
+        return;
+
     string sMessage;
     sMessage.append_format(QX_TEXT("[{}] "), svCondition);
     QX_LOGGER_INSTANCE.log(eVerbosity, sMessage, category, svFile, svFunction, nLine);
@@ -70,6 +75,9 @@ void resolve_assert_proceeding(
     format_string_strong_checks<args_t...> sFormat,
     args_t&&... args)
 {
+    if (!QX_LOGGER_INSTANCE.will_any_stream_accept(fileCategory, eVerbosity, svFile, svFunction))
+        return;
+
     string sMessage;
     sMessage.append_format(QX_TEXT("[{}] "), svCondition);
     sMessage.append_format(sFormat, std::forward<args_t>(args)...);
@@ -88,6 +96,9 @@ void resolve_assert_proceeding(
     // ... args
     string_view svMessage)
 {
+    if (!QX_LOGGER_INSTANCE.will_any_stream_accept(fileCategory, eVerbosity, svFile, svFunction))
+        return;
+
     string sMessage;
     sMessage.append_format(QX_TEXT("[{}] {}"), svCondition, svMessage);
     QX_LOGGER_INSTANCE.log(eVerbosity, sMessage, fileCategory, svFile, svFunction, nLine);
@@ -108,6 +119,9 @@ void resolve_assert_proceeding(
     format_string_strong_checks<args_t...> sFormat,
     args_t&&... args)
 {
+    if (!QX_LOGGER_INSTANCE.will_any_stream_accept(category, eVerbosity, svFile, svFunction))
+        return;
+
     string sMessage;
     sMessage.append_format(QX_TEXT("[{}] "), svCondition);
     sMessage.append_format(sFormat, std::forward<args_t>(args)...);
@@ -127,29 +141,162 @@ void resolve_assert_proceeding(
     const category& category,
     string_view     svMessage)
 {
+    if (!QX_LOGGER_INSTANCE.will_any_stream_accept(category, eVerbosity, svFile, svFunction))
+        return;
+
     string sMessage;
     sMessage.append_format(QX_TEXT("[{}] {}"), svCondition, svMessage);
     QX_LOGGER_INSTANCE.log(eVerbosity, sMessage, category, svFile, svFunction, nLine);
     QX_LOGGER_INSTANCE.flush();
 }
 
+/**
+
+    @class   assert_failure_counter
+    @brief   Call site failures counter
+    @details The first failure is reported in full, the next ones are counted
+             and reported as an aggregated count at most once per period
+    @author  Khrapov
+    @date    17.10.2026
+
+**/
+class assert_failure_counter
+{
+public:
+    enum class report
+    {
+        full,
+        aggregated,
+        none
+    };
+
+public:
+    QX_NONCOPYMOVABLE(assert_failure_counter);
+
+    /**
+        @brief assert_failure_counter object constructor
+        @param reportPeriod - min period between aggregated reports
+    **/
+    assert_failure_counter(std::chrono::steady_clock::duration reportPeriod) noexcept : m_Limiter(1, reportPeriod)
+    {
+    }
+
+    /**
+        @brief  Count a failure
+        @param  nNewFailures - failures since the previous report including this one, set only for aggregated report
+        @param  nFailures    - failures in total, set only for aggregated report
+        @retval              - how to report this failure
+    **/
+    report on_failure(u64& nNewFailures, u64& nFailures) noexcept
+    {
+        const u64 nFailure = m_nFailures.fetch_add(1, std::memory_order_relaxed) + 1;
+
+        u64 nSuppressed = 0;
+        if (!m_Limiter.try_acquire(nSuppressed))
+            return report::none;
+
+        // the first failure starts the period, so it's never reported twice
+        if (nFailure == 1)
+            return report::full;
+
+        nNewFailures = nSuppressed + 1;
+        nFailures    = nFailure;
+        return report::aggregated;
+    }
+
+private:
+    std::atomic<u64> m_nFailures = 0;
+    log_rate_limiter m_Limiter;
+};
+
+template<verbosity eVerbosity>
+void report_assert_failures(
+    const category& fileCategory,
+    string_view     svFunction,
+    string_view     svFile,
+    int             nLine,
+    string_view     svCondition,
+    u64             nNewFailures,
+    u64             nFailures)
+{
+    // aggregated reports don't flush: the first failure has already been flushed
+    QX_LOGGER_INSTANCE.log(
+        eVerbosity,
+        QX_TEXT("[{}] failed {} more times, {} in total"),
+        fileCategory,
+        svFile,
+        svFunction,
+        nLine,
+        svCondition,
+        nNewFailures,
+        nFailures);
+}
+
 } // namespace qx::details
 
 // ----------------------------------- setup -----------------------------------
 
+#ifndef QX_CONF_ASSERT_FAILURE_REPORT_PERIOD
+    #define QX_CONF_ASSERT_FAILURE_REPORT_PERIOD std::chrono::seconds(1)
+#endif
+
+// qxFunction is passed to the _QX_ASSERT lambda from outside, otherwise it would be the call operator name
+#define _QX_RESOLVE_ASSERT_PROCEEDING(eVerbosity, svCondition, ...) \
+    qx::details::resolve_assert_proceeding<eVerbosity>(             \
+        QX_FILE_CATEGORY(),                                         \
+        qxFunction,                                                 \
+        QX_SHORT_FILE,                                              \
+        QX_LINE,                                                    \
+        svCondition,                                                \
+        ##__VA_ARGS__)
+
+// the lambda type is unique for every call site, so is the counter
+#define _QX_RESOLVE_COUNTED_ASSERT_PROCEEDING(eVerbosity, svCondition, ...)                                    \
+    [&]()                                                                                                      \
+    {                                                                                                          \
+        static qx::details::assert_failure_counter qxFailureCounter(QX_CONF_ASSERT_FAILURE_REPORT_PERIOD);     \
+                                                                                                               \
+        u64 nNewFailures = 0;                                                                                  \
+        u64 nFailures    = 0;                                                                                  \
+        switch (qxFailureCounter.on_failure(nNewFailures, nFailures))                                          \
+        {                                                                                                      \
+        case qx::details::assert_failure_counter::report::full:                                                \
+            _QX_RESOLVE_ASSERT_PROCEEDING(eVerbosity, svCondition, ##__VA_ARGS__);                             \
+            break;                                                                                             \
+                                                                                                               \
+        case qx::details::assert_failure_counter::report::aggregated:                                          \
+            qx::details::report_assert_failures<eVerbosity>(                                                   \
+                QX_FILE_CATEGORY(),                                                                            \
+                qxFunction,                                                                                    \
+                QX_SHORT_FILE,                                                                                 \
+                QX_LINE,                                                                                       \
+                svCondition,                                                                                   \
+                nNewFailures,                                                                                  \
+                nFailures);                                                                                    \
+            break;                                                                                             \
+                                                                                                               \
+        default:                                                                                               \
+            break;                                                                                             \
+        }                                                                                                      \
+    }()
+
+/*
+    Define QX_CONF_ASSERT_FAILURE_COUNTER to report only the first failure of every call site in full
+    and then failure counts at most once per QX_CONF_ASSERT_FAILURE_REPORT_PERIOD without log flushes
+*/
+#ifdef QX_CONF_ASSERT_FAILURE_COUNTER
+    #define _QX_RESOLVE_ASSERT_FAILURE _QX_RESOLVE_COUNTED_ASSERT_PROCEEDING
+#else
+    #define _QX_RESOLVE_ASSERT_FAILURE _QX_RESOLVE_ASSERT_PROCEEDING
+#endif
+
 #ifndef QX_DEBUG_BREAK
     #define QX_DEBUG_BREAK _QX_DEBUG_BREAK
 #endif
 
 #ifndef QX_EXPECT_BEFORE_DEBUG_BREAK
-    #define QX_EXPECT_BEFORE_DEBUG_BREAK(condition, ...)              \
-        qx::details::resolve_assert_proceeding<qx::verbosity::error>( \
-            QX_FILE_CATEGORY(),                                       \
-            qx::to_string(__FUNCTION__),                              \
-            QX_SHORT_FILE,                                            \
-            QX_LINE,                                                  \
-            QX_TEXT(#condition),                                      \
-            ##__VA_ARGS__)
+    #define QX_EXPECT_BEFORE_DEBUG_BREAK(condition, ...) \
+        _QX_RESOLVE_ASSERT_FAILURE(qx::verbosity::error, QX_TEXT(#condition), ##__VA_ARGS__)
 #endif
 
 #ifndef QX_EXPECT_DEBUG_BREAK
@@ -165,14 +312,8 @@ void resolve_assert_proceeding(
 #endif
 
 #ifndef QX_ASSERT_BEFORE_DEBUG_BREAK
-    #define QX_ASSERT_BEFORE_DEBUG_BREAK(condition, ...)                 \
-        qx::details::resolve_assert_proceeding<qx::verbosity::critical>( \
-            QX_FILE_CATEGORY(),                                          \
-            qx::to_string(__FUNCTION__),                                 \
-            QX_SHORT_FILE,                                               \
-            QX_LINE,                                                     \
-            QX_TEXT(#condition),                                         \
-            ##__VA_ARGS__)
+    #define QX_ASSERT_BEFORE_DEBUG_BREAK(condition, ...) \
+        _QX_RESOLVE_ASSERT_FAILURE(qx::verbosity::critical, QX_TEXT(#condition), ##__VA_ARGS__)
 #endif
 
 #ifndef QX_ASSERT_DEBUG_BREAK
@@ -190,7 +331,7 @@ void resolve_assert_proceeding(
 // ------------------------------- common macros -------------------------------
 
 #define _QX_ASSERT(before_debug_break, debug_break, after_debug_break, condition, ...) \
-    [&]()                                                                              \
+    [&]([[maybe_unused]] qx::string_view qxFunction)                                   \
     {                                                                                  \
         QX_PUSH_SUPPRESS_MSVC_WARNINGS(4702);                                          \
         if (!(condition)) [[unlikely]]                                                 \
@@ -205,7 +346,7 @@ void resolve_assert_proceeding(
             return true;                                                               \
         }                                                                              \
         QX_POP_SUPPRESS_WARNINGS();                                                    \
-    }()
+    }(QX_FUNCTION_NAME)
 
 #define _QX_ASSERT_NO_ENTRY(before_debug_break, debug_break, after_debug_break, ...) \
     _QX_ASSERT(before_debug_break, debug_break, after_debug_break, !QX_TEXT("No entry"), ##__VA_ARGS__)
@@ -9,8 +9,11 @@
 #pragma once
 
 #include <qx/containers/string/string_setup.h>
+#include <qx/containers/string/string_view.h>
 #include <qx/meta/qualifiers.h>
 
+#include <iterator>
+
 /**
     @def     QX_EMPTY_MACRO
     @brief   Placeholder for disabled macros
@@ -69,6 +72,37 @@ constexpr const char_type* last_slash(const char_type* str)
 **/
 #define QX_SHORT_FILE qx::details::last_slash(QX_TEXT(__FILE__))
 
+namespace qx::details
+{
+
+template<size_t nSize>
+struct function_name
+{
+    constexpr function_name(const char (&pszName)[nSize]) noexcept
+    {
+        // function names are ASCII, so widening char by char is enough
+        for (size_t i = 0; i < nSize; ++i)
+            szName[i] = static_cast<char_type>(pszName[i]);
+    }
+
+    char_type szName[nSize] = {};
+};
+
+template<function_name name>
+constexpr string_view get_function_name() noexcept
+{
+    return string_view(name.szName, std::size(name.szName) - 1);
+}
+
+} // namespace qx::details
+
+/**
+    @def   QX_FUNCTION_NAME
+    @brief Current function name as qx::string_view
+           Converted to qx::char_type at compile time once per function, so it doesn't allocate
+**/
+#define QX_FUNCTION_NAME qx::details::get_function_name<qx::details::function_name(__FUNCTION__)>()
+
 /**
     @def   QX_SINGLE_ARGUMENT
     @brief Let macro param containing commas work fine
@@ -11,6 +11,8 @@
 #include <qx/containers/flags.h>
 #include <qx/typedefs.h>
 
+#include <atomic>
+
 namespace qx
 {
 
@@ -0,0 +1,172 @@
+/**
+
+    @file      allocation_tracker.h
+    @brief     Attribution of heap allocations to perf scopes, enabled with QX_CONF_USE_ALLOCATION_TRACKER
+    @details   Allocations are counted in the profiler call tree, so QX_CONF_USE_PROFILER
+               and profiler::start_call_tree() are required to see them per scope.
+               Global operator new and delete are hooked with QX_DEFINE_ALLOCATION_TRACKER_NEW_DELETE(),
+               qx::basic_string memory is hooked when QX_CONF_USE_ALLOCATION_TRACKER is defined
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+#pragma once
+
+#include <qx/macros/config.h>
+#include <qx/profiler/profiler.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+namespace qx
+{
+
+/**
+
+    @class   allocation_tracker
+    @brief   Allocation functions which count allocations in the innermost perf scope of the current thread
+    @details Reallocations are counted as allocations of the new size
+    @author  Khrapov
+    @date    17.10.2026
+
+**/
+class allocation_tracker
+{
+public:
+    /**
+        @brief  Allocate memory
+        @param  nBytes     - number of bytes
+        @param  nAlignment - alignment, 0 for the default malloc alignment
+        @retval            - allocated memory or nullptr
+    **/
+    static void* allocate(size_t nBytes, size_t nAlignment = 0) noexcept;
+
+    /**
+        @brief Free memory allocated with allocate()
+        @param pBlock     - memory block, may be nullptr
+        @param nAlignment - alignment used for allocation
+    **/
+    static void deallocate(void* pBlock, size_t nAlignment = 0) noexcept;
+
+    /**
+        @brief  std::realloc with tracking
+        @param  pBlock - memory block allocated with allocate() or reallocate(), may be nullptr
+        @param  nBytes - new number of bytes
+        @retval        - reallocated memory or nullptr
+    **/
+    static void* reallocate(void* pBlock, size_t nBytes) noexcept;
+};
+
+namespace details
+{
+
+/**
+    @brief  Allocate memory for operator new
+    @param  nBytes     - number of bytes
+    @param  nAlignment - alignment, 0 for the default malloc alignment
+    @retval            - allocated memory
+    @throws std::bad_alloc if there is no memory and new handler is not set
+**/
+void* tracked_operator_new(size_t nBytes, size_t nAlignment);
+
+/**
+    @brief  Allocate memory for nothrow operator new
+    @param  nBytes     - number of bytes
+    @param  nAlignment - alignment, 0 for the default malloc alignment
+    @retval            - allocated memory or nullptr
+**/
+void* tracked_operator_new_nothrow(size_t nBytes, size_t nAlignment) noexcept;
+
+} // namespace details
+
+} // namespace qx
+
+/**
+    @brief Replace global operator new and delete with tracking ones
+           Use this macro once at the global namespace scope of one translation unit of the executable
+**/
+#define QX_DEFINE_ALLOCATION_TRACKER_NEW_DELETE()                                                                  \
+    void* operator new(std::size_t nBytes)                                                                          \
+    {                                                                                                               \
+        return qx::details::tracked_operator_new(nBytes, 0);                                                        \
+    }                                                                                                               \
+    void* operator new[](std::size_t nBytes)                                                                        \
+    {                                                                                                               \
+        return qx::details::tracked_operator_new(nBytes, 0);                                                        \
+    }                                                                                                               \
+    void* operator new(std::size_t nBytes, const std::nothrow_t&) noexcept                                          \
+    {                                                                                                               \
+        return qx::details::tracked_operator_new_nothrow(nBytes, 0);                                                \
+    }                                                                                                               \
+    void* operator new[](std::size_t nBytes, const std::nothrow_t&) noexcept                                        \
+    {                                                                                                               \
+        return qx::details::tracked_operator_new_nothrow(nBytes, 0);                                                \
+    }                                                                                                               \
+    void* operator new(std::size_t nBytes, std::align_val_t eAlignment)                                             \
+    {                                                                                                               \
+        return qx::details::tracked_operator_new(nBytes, static_cast<std::size_t>(eAlignment));                     \
+    }                                                                                                               \
+    void* operator new[](std::size_t nBytes, std::align_val_t eAlignment)                                           \
+    {                                                                                                               \
+        return qx::details::tracked_operator_new(nBytes, static_cast<std::size_t>(eAlignment));                     \
+    }                                                                                                               \
+    void* operator new(std::size_t nBytes, std::align_val_t eAlignment, const std::nothrow_t&) noexcept             \
+    {                                                                                                               \
+        return qx::details::tracked_operator_new_nothrow(nBytes, static_cast<std::size_t>(eAlignment));             \
+    }                                                                                                               \
+    void* operator new[](std::size_t nBytes, std::align_val_t eAlignment, const std::nothrow_t&) noexcept           \
+    {                                                                                                               \
+        return qx::details::tracked_operator_new_nothrow(nBytes, static_cast<std::size_t>(eAlignment));             \
+    }                                                                                                               \
+    void operator delete(void* pBlock) noexcept                                                                     \
+    {                                                                                                               \
+        qx::allocation_tracker::deallocate(pBlock);                                                                 \
+    }                                                                                                               \
+    void operator delete[](void* pBlock) noexcept                                                                   \
+    {                                                                                                               \
+        qx::allocation_tracker::deallocate(pBlock);                                                                 \
+    }                                                                                                               \
+    void operator delete(void* pBlock, std::size_t) noexcept                                                        \
+    {                                                                                                               \
+        qx::allocation_tracker::deallocate(pBlock);                                                                 \
+    }                                                                                                               \
+    void operator delete[](void* pBlock, std::size_t) noexcept                                                      \
+    {                                                                                                               \
+        qx::allocation_tracker::deallocate(pBlock);                                                                 \
+    }                                                                                                               \
+    void operator delete(void* pBlock, const std::nothrow_t&) noexcept                                              \
+    {                                                                                                               \
+        qx::allocation_tracker::deallocate(pBlock);                                                                 \
+    }                                                                                                               \
+    void operator delete[](void* pBlock, const std::nothrow_t&) noexcept                                            \
+    {                                                                                                               \
+        qx::allocation_tracker::deallocate(pBlock);                                                                 \
+    }                                                                                                               \
+    void operator delete(void* pBlock, std::align_val_t eAlignment) noexcept                                        \
+    {                                                                                                               \
+        qx::allocation_tracker::deallocate(pBlock, static_cast<std::size_t>(eAlignment));                           \
+    }                                                                                                               \
+    void operator delete[](void* pBlock, std::align_val_t eAlignment) noexcept                                      \
+    {                                                                                                               \
+        qx::allocation_tracker::deallocate(pBlock, static_cast<std::size_t>(eAlignment));                           \
+    }                                                                                                               \
+    void operator delete(void* pBlock, std::size_t, std::align_val_t eAlignment) noexcept                           \
+    {                                                                                                               \
+        qx::allocation_tracker::deallocate(pBlock, static_cast<std::size_t>(eAlignment));                           \
+    }                                                                                                               \
+    void operator delete[](void* pBlock, std::size_t, std::align_val_t eAlignment) noexcept                         \
+    {                                                                                                               \
+        qx::allocation_tracker::deallocate(pBlock, static_cast<std::size_t>(eAlignment));                           \
+    }                                                                                                               \
+    void operator delete(void* pBlock, std::align_val_t eAlignment, const std::nothrow_t&) noexcept                  \
+    {                                                                                                               \
+        qx::allocation_tracker::deallocate(pBlock, static_cast<std::size_t>(eAlignment));                           \
+    }                                                                                                               \
+    void operator delete[](void* pBlock, std::align_val_t eAlignment, const std::nothrow_t&) noexcept                \
+    {                                                                                                               \
+        qx::allocation_tracker::deallocate(pBlock, static_cast<std::size_t>(eAlignment));                           \
+    }
+
+#include <qx/profiler/allocation_tracker.inl>
@@ -0,0 +1,97 @@
+/**
+
+    @file      allocation_tracker.inl
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+
+namespace qx
+{
+
+inline void* allocation_tracker::allocate(size_t nBytes, size_t nAlignment) noexcept
+{
+    void* pBlock = nullptr;
+
+    if (nAlignment == 0)
+    {
+        pBlock = std::malloc(nBytes > 0 ? nBytes : 1);
+    }
+    else
+    {
+#if QX_MSVC
+        pBlock = _aligned_malloc(nBytes > 0 ? nBytes : 1, nAlignment);
+#else
+        // aligned_alloc requires the size to be a multiple of the alignment
+        const size_t nAlignedBytes = (nBytes + nAlignment - 1) & ~(nAlignment - 1);
+        pBlock                     = std::aligned_alloc(nAlignment, std::max(nAlignedBytes, nAlignment));
+#endif
+    }
+
+    if (pBlock)
+        profiler::record_allocation(nBytes);
+
+    return pBlock;
+}
+
+inline void allocation_tracker::deallocate(void* pBlock, [[maybe_unused]] size_t nAlignment) noexcept
+{
+    if (!pBlock)
+        return;
+
+    profiler::record_deallocation();
+
+#if QX_MSVC
+    if (nAlignment > 0)
+    {
+        _aligned_free(pBlock);
+        return;
+    }
+#endif
+
+    std::free(pBlock);
+}
+
+inline void* allocation_tracker::reallocate(void* pBlock, size_t nBytes) noexcept
+{
+    void* pNewBlock = std::realloc(pBlock, nBytes);
+    if (pNewBlock)
+        profiler::record_allocation(nBytes);
+
+    return pNewBlock;
+}
+
+namespace details
+{
+
+inline void* tracked_operator_new(size_t nBytes, size_t nAlignment)
+{
+    while (true)
+    {
+        if (void* pBlock = allocation_tracker::allocate(nBytes, nAlignment))
+            return pBlock;
+
+        const std::new_handler newHandler = std::get_new_handler();
+        if (!newHandler)
+            throw std::bad_alloc();
+
+        newHandler();
+    }
+}
+
+inline void* tracked_operator_new_nothrow(size_t nBytes, size_t nAlignment) noexcept
+{
+    try
+    {
+        return tracked_operator_new(nBytes, nAlignment);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+} // namespace details
+
+} // namespace qx
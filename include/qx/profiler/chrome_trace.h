@@ -0,0 +1,37 @@
+/**
+
+    @file      chrome_trace.h
+    @brief     Export of profiler events as Chrome trace / Perfetto JSON
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+#pragma once
+
+#include <qx/category.h>
+#include <qx/containers/string/string_converters.h>
+#include <qx/internal/json.h>
+#include <qx/profiler/profiler.h>
+
+#include <format>
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace qx
+{
+
+/**
+    @brief   Write events recorded by the profiler as Chrome trace / Perfetto JSON
+    @details Written events are removed from the profiler buffers, so the function may be called periodically
+             to write consecutive parts of the trace. Open the output in chrome://tracing or ui.perfetto.dev
+    @param   stream - output stream
+    @retval         - number of written events
+**/
+size_t export_chrome_trace(std::ostream& stream);
+
+} // namespace qx
+
+#include <qx/profiler/chrome_trace.inl>
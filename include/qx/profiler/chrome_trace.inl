@@ -0,0 +1,62 @@
+/**
+
+    @file      chrome_trace.inl
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+
+namespace qx
+{
+
+inline size_t export_chrome_trace(std::ostream& stream)
+{
+    const profiler_thread_pause threadPause;
+
+    const u64    nStartTicks          = profiler::get_start_ticks();
+    const double fTicksPerMicrosecond = profiler::get_ticks_per_microsecond();
+
+    std::string sEvent;
+    std::string sCategory;
+    size_t      nEvents = 0;
+
+    stream << "{\"traceEvents\":[";
+
+    const u64 nDroppedEvents = profiler::consume_events(
+        [&](u32 nThreadId, const profiler_event& event)
+        {
+            sEvent.clear();
+            sEvent += nEvents > 0 ? ",\n" : "\n";
+
+            std::format_to(std::back_inserter(sEvent), "{{\"ph\":\"X\",\"pid\":1,\"tid\":{},\"name\":\"", nThreadId);
+            details::append_json_escaped(sEvent, event.pszName);
+            sEvent += '"';
+
+            if (event.pCategory)
+            {
+                const string_view svCategory = event.pCategory->get_name();
+                sCategory.resize(get_max_utf8_size<char_type>(svCategory.size()));
+                sCategory.resize(encode_utf8(svCategory, sCategory.data()));
+
+                sEvent += ",\"cat\":\"";
+                details::append_json_escaped(sEvent, sCategory);
+                sEvent += '"';
+            }
+
+            std::format_to(
+                std::back_inserter(sEvent),
+                ",\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                static_cast<double>(event.nBeginTicks - nStartTicks) / fTicksPerMicrosecond,
+                static_cast<double>(event.nEndTicks - event.nBeginTicks) / fTicksPerMicrosecond);
+
+            stream.write(sEvent.data(), static_cast<std::streamsize>(sEvent.size()));
+            ++nEvents;
+        });
+
+    stream << "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"droppedEvents\":" << nDroppedEvents << "}}\n";
+
+    return nEvents;
+}
+
+} // namespace qx
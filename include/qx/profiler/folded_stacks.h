@@ -0,0 +1,60 @@
+/**
+
+    @file      folded_stacks.h
+    @brief     Export of the profiler call tree as folded stacks for flame graphs
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+#pragma once
+
+#include <qx/profiler/profiler.h>
+
+#include <format>
+#include <iterator>
+#include <ostream>
+#include <string>
+
+namespace qx
+{
+
+/**
+    @enum  folded_stacks_value
+    @brief Value of a stack in folded stacks
+**/
+enum class folded_stacks_value
+{
+    exclusive_time,  //!< exclusive nanoseconds
+    allocations,     //!< number of allocations, see QX_CONF_USE_ALLOCATION_TRACKER
+    allocated_bytes, //!< allocated bytes, see QX_CONF_USE_ALLOCATION_TRACKER
+};
+
+/**
+    @brief   Write a call tree as Brendan Gregg folded stacks: "outer;inner;innermost <value>" per line
+    @details Use flamegraph.pl or speedscope to draw a flame graph. ';' in scope names are replaced with ':'
+    @param   stream   - output stream
+    @param   callTree - call tree root
+    @param   eValue   - value of a stack
+    @retval           - number of written stacks
+**/
+size_t export_folded_stacks(
+    std::ostream&                  stream,
+    const profiler_call_tree_node& callTree,
+    folded_stacks_value            eValue = folded_stacks_value::exclusive_time);
+
+/**
+    @brief  Collect call trees of all threads and write the result as folded stacks
+    @param  stream - output stream
+    @param  eValue - value of a stack
+    @param  bReset - reset counters of the collected nodes, so the next export covers only the time after this one
+    @retval        - number of written stacks
+**/
+size_t export_folded_stacks(
+    std::ostream&       stream,
+    folded_stacks_value eValue = folded_stacks_value::exclusive_time,
+    bool                bReset = false);
+
+} // namespace qx
+
+#include <qx/profiler/folded_stacks.inl>
@@ -0,0 +1,93 @@
+/**
+
+    @file      folded_stacks.inl
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+
+namespace qx
+{
+
+namespace details
+{
+
+inline u64 get_folded_stack_value(
+    const profiler_call_tree_node& node,
+    folded_stacks_value            eValue,
+    double                         fTicksPerNanosecond) noexcept
+{
+    switch (eValue)
+    {
+    case folded_stacks_value::allocations:
+        return node.nAllocations;
+
+    case folded_stacks_value::allocated_bytes:
+        return node.nAllocatedBytes;
+
+    default:
+        return static_cast<u64>(static_cast<double>(node.nExclusiveTicks) / fTicksPerNanosecond + 0.5);
+    }
+}
+
+inline void append_folded_stacks(
+    std::string&                   sStacks,
+    std::string&                   sPath,
+    const profiler_call_tree_node& node,
+    folded_stacks_value            eValue,
+    double                         fTicksPerNanosecond,
+    size_t&                        nStacks)
+{
+    for (const auto& [svName, pChild] : node.children)
+    {
+        const profiler_call_tree_node& child = *pChild;
+
+        const size_t nPathSize = sPath.size();
+
+        if (nPathSize > 0)
+            sPath += ';';
+
+        for (const char ch : svName)
+            sPath += ch == ';' || ch == '\n' ? ':' : ch;
+
+        if (const u64 nValue = get_folded_stack_value(child, eValue, fTicksPerNanosecond); nValue > 0)
+        {
+            std::format_to(std::back_inserter(sStacks), "{} {}\n", sPath, nValue);
+            ++nStacks;
+        }
+
+        append_folded_stacks(sStacks, sPath, child, eValue, fTicksPerNanosecond, nStacks);
+        sPath.resize(nPathSize);
+    }
+}
+
+} // namespace details
+
+inline size_t export_folded_stacks(
+    std::ostream&                  stream,
+    const profiler_call_tree_node& callTree,
+    folded_stacks_value            eValue)
+{
+    std::string sStacks;
+    std::string sPath;
+    size_t      nStacks = 0;
+
+    const double fTicksPerNanosecond =
+        eValue == folded_stacks_value::exclusive_time ? profiler::get_ticks_per_microsecond() / 1000.0 : 1.0;
+
+    details::append_folded_stacks(sStacks, sPath, callTree, eValue, fTicksPerNanosecond, nStacks);
+
+    stream.write(sStacks.data(), static_cast<std::streamsize>(sStacks.size()));
+
+    return nStacks;
+}
+
+inline size_t export_folded_stacks(std::ostream& stream, folded_stacks_value eValue, bool bReset)
+{
+    const profiler_thread_pause threadPause;
+
+    return export_folded_stacks(stream, profiler::collect_call_tree(bReset), eValue);
+}
+
+} // namespace qx
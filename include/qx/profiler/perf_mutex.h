@@ -0,0 +1,152 @@
+/**
+
+    @file      perf_mutex.h
+    @brief     Instrumented mutexes for QX_PERF_MUTEX and QX_PERF_SHARED_MUTEX, enabled with QX_CONF_USE_PERF_MUTEX
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+#pragma once
+
+#include <qx/profiler/profiler.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <format>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+
+namespace qx
+{
+
+/**
+
+    @struct  perf_mutex_stats
+    @brief   Lock statistics of all mutexes with the same name
+    @details Durations are in profiler ticks, histogram bucket i counts durations of [2^(i-1), 2^i) ticks.
+             Hold time is measured only for exclusive locks
+    @author  Khrapov
+    @date    17.10.2026
+
+**/
+struct perf_mutex_stats
+{
+    static constexpr size_t k_nBuckets = 64;
+
+    using histogram = std::array<std::atomic<u64>, k_nBuckets>;
+
+    std::atomic<u64> nAcquisitions          = 0;
+    std::atomic<u64> nContendedAcquisitions = 0;
+    std::atomic<u64> nSharedAcquisitions    = 0;
+    std::atomic<u64> nContendedShared       = 0;
+    std::atomic<u64> nWaitTicks             = 0;
+    std::atomic<u64> nHoldTicks             = 0;
+    histogram        waitHistogram {};
+    histogram        holdHistogram {};
+
+    /**
+        @brief Add a duration to a histogram
+        @param histogram - histogram to add to
+        @param nTicks    - duration in ticks
+    **/
+    static void add_to_histogram(histogram& histogram, u64 nTicks) noexcept;
+
+    /**
+        @brief  Get approximate percentile of a histogram
+        @param  histogram   - histogram
+        @param  fPercentile - percentile in [0, 1]
+        @retval             - upper bound of the bucket with the percentile in ticks
+    **/
+    static u64 get_percentile(const histogram& histogram, double fPercentile) noexcept;
+};
+
+/**
+    @brief  Get stats of mutexes with this name, create them if there are none
+    @param  svName - mutex name, must be a string literal
+    @retval        - mutex stats, never deleted
+**/
+perf_mutex_stats& get_perf_mutex_stats(std::string_view svName);
+
+/**
+    @brief  Process stats of all mutex names
+    @tparam stats_func_t - function type, void(std::string_view svName, const perf_mutex_stats& stats)
+    @param  statsFunc    - function processing stats, called in the name order
+**/
+template<class stats_func_t>
+void for_each_perf_mutex_stats(stats_func_t&& statsFunc);
+
+/**
+    @brief Write a text table of stats of all mutex names
+    @param stream - output stream
+**/
+void report_perf_mutex_stats(std::ostream& stream);
+
+/**
+
+    @class   basic_perf_mutex
+    @brief   Drop-in mutex wrapper which counts acquisitions, contended acquisitions, wait and hold time
+    @details Stats are shared by all mutexes with the same name, e.g. member mutexes of all objects of a class.
+             Uncontended lock costs one try_lock, two tick reads and a few relaxed atomic increments
+    @tparam  mutex_t - mutex type, std::mutex or std::shared_mutex
+    @author  Khrapov
+    @date    17.10.2026
+
+**/
+template<class mutex_t>
+class basic_perf_mutex
+{
+public:
+    QX_NONCOPYMOVABLE(basic_perf_mutex);
+
+    /**
+        @brief basic_perf_mutex object constructor
+        @param svName - mutex name, must be a string literal
+    **/
+    explicit basic_perf_mutex(std::string_view svName);
+
+    void lock();
+    bool try_lock();
+    void unlock();
+
+    void lock_shared()
+        requires requires(mutex_t& mutex) { mutex.lock_shared(); };
+
+    bool try_lock_shared()
+        requires requires(mutex_t& mutex) { mutex.try_lock_shared(); };
+
+    void unlock_shared()
+        requires requires(mutex_t& mutex) { mutex.unlock_shared(); };
+
+    /**
+        @brief  Get stats of mutexes with this name
+        @retval  - mutex stats
+    **/
+    const perf_mutex_stats& get_stats() const noexcept;
+
+private:
+    /**
+        @brief Count an exclusive acquisition
+        @param nWaitTicks - wait duration, 0 if the mutex was not contended
+    **/
+    void on_locked(u64 nWaitTicks) noexcept;
+
+private:
+    mutex_t           m_Mutex;
+    perf_mutex_stats& m_Stats;
+    u64               m_nLockTicks = 0; // written only by the owner of the exclusive lock
+};
+
+using perf_mutex        = basic_perf_mutex<std::mutex>;
+using perf_shared_mutex = basic_perf_mutex<std::shared_mutex>;
+
+} // namespace qx
+
+#include <qx/profiler/perf_mutex.inl>
@@ -0,0 +1,227 @@
+/**
+
+    @file      perf_mutex.inl
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+
+namespace qx
+{
+
+namespace details
+{
+
+struct perf_mutex_registry
+{
+    std::mutex                                                     mutex;
+    std::map<std::string_view, std::unique_ptr<perf_mutex_stats>> stats;
+};
+
+inline perf_mutex_registry& get_perf_mutex_registry()
+{
+    static perf_mutex_registry registry;
+    return registry;
+}
+
+} // namespace details
+
+inline void perf_mutex_stats::add_to_histogram(histogram& histogram, u64 nTicks) noexcept
+{
+    const size_t nBucket = std::min<size_t>(static_cast<size_t>(std::bit_width(nTicks)), k_nBuckets - 1);
+    histogram[nBucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+inline u64 perf_mutex_stats::get_percentile(const histogram& histogram, double fPercentile) noexcept
+{
+    u64 nTotal = 0;
+    for (const auto& nCount : histogram)
+        nTotal += nCount.load(std::memory_order_relaxed);
+
+    if (nTotal == 0)
+        return 0;
+
+    const u64 nRank = std::max<u64>(static_cast<u64>(fPercentile * static_cast<double>(nTotal) + 0.5), 1);
+
+    u64 nCumulative = 0;
+    for (size_t i = 0; i < k_nBuckets; ++i)
+    {
+        nCumulative += histogram[i].load(std::memory_order_relaxed);
+        if (nCumulative >= nRank)
+            return i == 0 ? 0 : u64(1) << std::min<size_t>(i, 63);
+    }
+
+    return ~u64(0);
+}
+
+inline perf_mutex_stats& get_perf_mutex_stats(std::string_view svName)
+{
+    auto& registry = details::get_perf_mutex_registry();
+
+    std::lock_guard lock(registry.mutex);
+
+    auto& pStats = registry.stats[svName];
+    if (!pStats)
+        pStats = std::make_unique<perf_mutex_stats>();
+
+    return *pStats;
+}
+
+template<class stats_func_t>
+inline void for_each_perf_mutex_stats(stats_func_t&& statsFunc)
+{
+    auto& registry = details::get_perf_mutex_registry();
+
+    std::lock_guard lock(registry.mutex);
+
+    for (const auto& [svName, pStats] : registry.stats)
+        statsFunc(svName, *pStats);
+}
+
+inline void report_perf_mutex_stats(std::ostream& stream)
+{
+    const double fTicksPerMicrosecond = profiler::get_ticks_per_microsecond();
+
+    auto to_microseconds = [fTicksPerMicrosecond](u64 nTicks)
+    {
+        return static_cast<double>(nTicks) / fTicksPerMicrosecond;
+    };
+
+    std::string sReport = std::format(
+        "{:<32} {:>12} {:>12} {:>12} {:>12} {:>12} {:>12} {:>12}\n",
+        "mutex",
+        "locks",
+        "contended",
+        "shared",
+        "wait avg us",
+        "wait p99 us",
+        "hold avg us",
+        "hold p99 us");
+
+    for_each_perf_mutex_stats(
+        [&](std::string_view svName, const perf_mutex_stats& stats)
+        {
+            const u64 nAcquisitions = stats.nAcquisitions.load(std::memory_order_relaxed);
+            const u64 nContended    = stats.nContendedAcquisitions.load(std::memory_order_relaxed)
+                                   + stats.nContendedShared.load(std::memory_order_relaxed);
+
+            const u64    nWaitTicks = stats.nWaitTicks.load(std::memory_order_relaxed);
+            const u64    nHoldTicks = stats.nHoldTicks.load(std::memory_order_relaxed);
+            const double fAvgWait =
+                nContended > 0 ? to_microseconds(nWaitTicks) / static_cast<double>(nContended) : 0.0;
+            const double fAvgHold =
+                nAcquisitions > 0 ? to_microseconds(nHoldTicks) / static_cast<double>(nAcquisitions) : 0.0;
+
+            std::format_to(
+                std::back_inserter(sReport),
+                "{:<32} {:>12} {:>12} {:>12} {:>12.3f} {:>12.3f} {:>12.3f} {:>12.3f}\n",
+                svName,
+                nAcquisitions,
+                nContended,
+                stats.nSharedAcquisitions.load(std::memory_order_relaxed),
+                fAvgWait,
+                to_microseconds(perf_mutex_stats::get_percentile(stats.waitHistogram, 0.99)),
+                fAvgHold,
+                to_microseconds(perf_mutex_stats::get_percentile(stats.holdHistogram, 0.99)));
+        });
+
+    stream << sReport;
+}
+
+template<class mutex_t>
+inline basic_perf_mutex<mutex_t>::basic_perf_mutex(std::string_view svName) : m_Stats(get_perf_mutex_stats(svName))
+{
+}
+
+template<class mutex_t>
+inline void basic_perf_mutex<mutex_t>::lock()
+{
+    if (m_Mutex.try_lock())
+    {
+        on_locked(0);
+        return;
+    }
+
+    const u64 nWaitStartTicks = profiler::get_ticks();
+    m_Mutex.lock();
+    on_locked(std::max<u64>(profiler::get_ticks() - nWaitStartTicks, 1));
+}
+
+template<class mutex_t>
+inline bool basic_perf_mutex<mutex_t>::try_lock()
+{
+    if (!m_Mutex.try_lock())
+        return false;
+
+    on_locked(0);
+    return true;
+}
+
+template<class mutex_t>
+inline void basic_perf_mutex<mutex_t>::unlock()
+{
+    const u64 nHoldTicks = profiler::get_ticks() - m_nLockTicks;
+    m_Stats.nHoldTicks.fetch_add(nHoldTicks, std::memory_order_relaxed);
+    perf_mutex_stats::add_to_histogram(m_Stats.holdHistogram, nHoldTicks);
+
+    m_Mutex.unlock();
+}
+
+template<class mutex_t>
+inline void basic_perf_mutex<mutex_t>::lock_shared()
+    requires requires(mutex_t& mutex) { mutex.lock_shared(); }
+{
+    m_Stats.nSharedAcquisitions.fetch_add(1, std::memory_order_relaxed);
+
+    if (m_Mutex.try_lock_shared())
+        return;
+
+    const u64 nWaitStartTicks = profiler::get_ticks();
+    m_Mutex.lock_shared();
+    const u64 nWaitTicks = std::max<u64>(profiler::get_ticks() - nWaitStartTicks, 1);
+
+    m_Stats.nContendedShared.fetch_add(1, std::memory_order_relaxed);
+    m_Stats.nWaitTicks.fetch_add(nWaitTicks, std::memory_order_relaxed);
+    perf_mutex_stats::add_to_histogram(m_Stats.waitHistogram, nWaitTicks);
+}
+
+template<class mutex_t>
+inline bool basic_perf_mutex<mutex_t>::try_lock_shared()
+    requires requires(mutex_t& mutex) { mutex.try_lock_shared(); }
+{
+    if (!m_Mutex.try_lock_shared())
+        return false;
+
+    m_Stats.nSharedAcquisitions.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+template<class mutex_t>
+inline void basic_perf_mutex<mutex_t>::unlock_shared()
+    requires requires(mutex_t& mutex) { mutex.unlock_shared(); }
+{
+    m_Mutex.unlock_shared();
+}
+
+template<class mutex_t>
+inline const perf_mutex_stats& basic_perf_mutex<mutex_t>::get_stats() const noexcept
+{
+    return m_Stats;
+}
+
+template<class mutex_t>
+inline void basic_perf_mutex<mutex_t>::on_locked(u64 nWaitTicks) noexcept
+{
+    m_nLockTicks = profiler::get_ticks();
+    m_Stats.nAcquisitions.fetch_add(1, std::memory_order_relaxed);
+
+    if (nWaitTicks == 0)
+        return;
+
+    m_Stats.nContendedAcquisitions.fetch_add(1, std::memory_order_relaxed);
+    m_Stats.nWaitTicks.fetch_add(nWaitTicks, std::memory_order_relaxed);
+    perf_mutex_stats::add_to_histogram(m_Stats.waitHistogram, nWaitTicks);
+}
+
+} // namespace qx
@@ -0,0 +1,537 @@
+/**
+
+    @file      profiler.h
+    @brief     Built-in implementation of QX_PERF_SCOPE, enabled with QX_CONF_USE_PROFILER
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+#pragma once
+
+#include <qx/internal/cache_line.h>
+#include <qx/macros/copyable_movable.h>
+#include <qx/macros/suppress_warnings.h>
+#include <qx/typedefs.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(QX_CONF_PROFILER_USE_RDTSC) \
+    && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+    #define _QX_PROFILER_RDTSC 1
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <x86intrin.h>
+    #endif
+#else
+    #define _QX_PROFILER_RDTSC 0
+#endif
+
+#ifndef QX_CONF_PROFILER_THREAD_BUFFER_SIZE
+    // number of events, will be rounded up to the power of 2
+    #define QX_CONF_PROFILER_THREAD_BUFFER_SIZE (1 << 16)
+#endif
+
+#ifndef QX_CONF_PROFILER_CALL_TREE_SIZE
+    // number of call tree nodes per thread, scopes which don't fit are not aggregated
+    #define QX_CONF_PROFILER_CALL_TREE_SIZE (1 << 12)
+#endif
+
+namespace qx
+{
+
+class category;
+
+/**
+    @struct profiler_event
+    @brief  Finished perf scope
+**/
+struct profiler_event
+{
+    const char*     pszName     = nullptr;
+    const category* pCategory   = nullptr;
+    u64             nBeginTicks = 0;
+    u64             nEndTicks   = 0;
+};
+
+/**
+    @struct profiler_call_tree_node
+    @brief  Aggregated perf scope with the same path of scope names
+    @note   Allocations are counted only with QX_CONF_USE_ALLOCATION_TRACKER,
+            they are attributed to the innermost scope, so they are exclusive
+**/
+struct profiler_call_tree_node
+{
+    u64 nCalls          = 0;
+    u64 nInclusiveTicks = 0;
+    u64 nExclusiveTicks = 0;
+    u64 nAllocations    = 0;
+    u64 nAllocatedBytes = 0;
+    u64 nDeallocations  = 0;
+
+    // the node type is incomplete here, so children are held by pointers
+    std::map<std::string_view, std::unique_ptr<profiler_call_tree_node>> children;
+};
+
+namespace details
+{
+
+/**
+    @struct profiler_call_tree_frame
+    @brief  Open perf scope of the call tree of a thread
+**/
+struct profiler_call_tree_frame
+{
+    static constexpr u32 k_nInvalidNode = static_cast<u32>(-1);
+
+    u32                       nNode       = k_nInvalidNode;
+    u64                       nBeginTicks = 0;
+    u64                       nChildTicks = 0;
+    profiler_call_tree_frame* pParent     = nullptr;
+};
+
+/**
+
+    @class   profiler_thread_call_tree
+    @brief   Call tree of scope names of one thread with inclusive and exclusive time and call counts
+    @details Only the owner thread enters and leaves scopes. Nodes are never moved or removed and their names
+             and parents never change, so other threads may read published nodes without locks
+    @author  Khrapov
+    @date    17.10.2026
+
+**/
+class profiler_thread_call_tree
+{
+public:
+    struct node
+    {
+        const char*      pszName      = nullptr;
+        u32              nParent      = profiler_call_tree_frame::k_nInvalidNode;
+        u32              nFirstChild  = profiler_call_tree_frame::k_nInvalidNode;
+        u32              nNextSibling = profiler_call_tree_frame::k_nInvalidNode;
+        std::atomic<u64> nCalls          = 0;
+        std::atomic<u64> nInclusiveTicks = 0;
+        std::atomic<u64> nExclusiveTicks = 0;
+        std::atomic<u64> nAllocations    = 0;
+        std::atomic<u64> nAllocatedBytes = 0;
+        std::atomic<u64> nDeallocations  = 0;
+    };
+
+public:
+    QX_NONCOPYMOVABLE(profiler_thread_call_tree);
+
+    /**
+        @brief profiler_thread_call_tree object constructor
+        @param pNodes    - nodes memory
+        @param nCapacity - number of nodes
+    **/
+    profiler_thread_call_tree(std::unique_ptr<node[]> pNodes, u32 nCapacity) noexcept;
+
+    /**
+        @brief  Enter a child scope of the current scope, owner side
+        @param  frame   - frame of the new scope, must live until leave()
+        @param  pszName - scope name
+        @retval         - false if there is no space for a new node and the scope is not aggregated
+    **/
+    bool enter(profiler_call_tree_frame& frame, const char* pszName) noexcept;
+
+    /**
+        @brief Leave the current scope, owner side
+        @param frame     - frame of the current scope
+        @param nEndTicks - end ticks of the scope
+    **/
+    void leave(profiler_call_tree_frame& frame, u64 nEndTicks) noexcept;
+
+    /**
+        @brief Count an allocation in the current scope, owner side
+        @param nBytes - allocation size
+    **/
+    void record_allocation(size_t nBytes) noexcept;
+
+    /**
+        @brief Count a deallocation in the current scope, owner side
+    **/
+    void record_deallocation() noexcept;
+
+    /**
+        @brief  Process all published nodes, parents are processed before their children
+        @tparam node_func_t - function type, void(u32 nNode, node&)
+        @param  nodeFunc    - function processing a node
+    **/
+    template<class node_func_t>
+    void for_each_node(node_func_t&& nodeFunc);
+
+    /**
+        @brief  Check if no scopes are entered
+        @retval  - true if no scopes are entered
+    **/
+    bool empty() const noexcept;
+
+public:
+    std::atomic<bool>          bInUse = true; // false when the thread is finished
+    profiler_thread_call_tree* pNext  = nullptr;
+
+private:
+    std::unique_ptr<node[]>   m_pNodes;
+    u32                       m_nCapacity     = 0;
+    std::atomic<u32>          m_nNodes        = 1; // the first node is the root
+    profiler_call_tree_frame* m_pCurrentFrame = nullptr;
+};
+
+// positions are aligned to cache lines, so the class is padded (C4324)
+QX_PUSH_SUPPRESS_MSVC_WARNINGS(4324);
+
+/**
+
+    @class   profiler_thread_buffer
+    @brief   Single producer single consumer ring buffer of events of one thread
+    @details Memory is allocated once when the thread records its first event,
+             events which don't fit are dropped and counted
+    @author  Khrapov
+    @date    17.10.2026
+
+**/
+class profiler_thread_buffer
+{
+public:
+    QX_NONCOPYMOVABLE(profiler_thread_buffer);
+
+    /**
+        @brief profiler_thread_buffer object constructor
+        @param pEvents   - events memory
+        @param nCapacity - number of events, must be a power of 2
+        @param nThreadId - profiler thread id
+    **/
+    profiler_thread_buffer(std::unique_ptr<profiler_event[]> pEvents, size_t nCapacity, u32 nThreadId) noexcept;
+
+    /**
+        @brief  Push an event, producer side
+        @param  event - finished event
+        @retval       - false if there is no space and the event is dropped
+    **/
+    bool try_push(const profiler_event& event) noexcept;
+
+    /**
+        @brief  Process all pushed events and free their space, consumer side
+        @tparam consume_func_t - function type, void(const profiler_event&)
+        @param  consumeFunc    - function processing an event
+    **/
+    template<class consume_func_t>
+    void consume_all(consume_func_t&& consumeFunc);
+
+    /**
+        @brief  Check if there are no pushed events
+        @retval  - true if there are no pushed events
+    **/
+    bool empty() const noexcept;
+
+    /**
+        @brief  Get profiler thread id
+        @retval  - thread id, unique for every thread which recorded events
+    **/
+    u32 get_thread_id() const noexcept;
+
+    /**
+        @brief  Get number of dropped events and reset it
+        @retval  - number of events dropped since the previous call
+    **/
+    u64 take_dropped_events_count() noexcept;
+
+    /**
+        @brief Attach the buffer to a new thread
+        @param nThreadId - new profiler thread id
+    **/
+    void reuse(u32 nThreadId) noexcept;
+
+public:
+    std::atomic<bool>       bInUse = true; // false when the thread is finished
+    profiler_thread_buffer* pNext  = nullptr;
+
+private:
+    std::unique_ptr<profiler_event[]> m_pEvents;
+    size_t                            m_nMask     = 0;
+    std::atomic<u32>                  m_nThreadId = 0;
+    std::atomic<u64>                  m_nDroppedEvents = 0;
+
+    alignas(k_nCacheLineSize) std::atomic<size_t> m_nWritePos = 0;
+    alignas(k_nCacheLineSize) std::atomic<size_t> m_nReadPos  = 0;
+};
+
+QX_POP_SUPPRESS_WARNINGS();
+
+} // namespace details
+
+/**
+
+    @class   profiler
+    @brief   Process wide profiler used by QX_PERF_SCOPE when QX_CONF_USE_PROFILER is defined
+    @details Every thread records finished scopes to its own buffer without locks and allocations.
+             Ticks are steady clock nanoseconds or rdtsc cycles if QX_CONF_PROFILER_USE_RDTSC is defined.
+             Recording is enabled from the start.
+             Scopes may also be aggregated to per-thread call trees, which are small enough
+             to be collected periodically instead of full traces
+    @author  Khrapov
+    @date    17.10.2026
+
+**/
+class profiler
+{
+    using clock = std::chrono::steady_clock;
+
+    struct start_point
+    {
+        u64               nTicks = 0;
+        clock::time_point time;
+    };
+
+public:
+    /**
+        @brief Enable recording
+    **/
+    static void start() noexcept;
+
+    /**
+        @brief Disable recording, scopes started before the call are still recorded
+    **/
+    static void stop() noexcept;
+
+    /**
+        @brief  Check if recording is enabled
+        @retval  - true if recording is enabled
+    **/
+    static bool is_recording() noexcept;
+
+    /**
+        @brief  Get current ticks
+        @retval  - current ticks
+    **/
+    static u64 get_ticks() noexcept;
+
+    /**
+        @brief  Get ticks of the first profiler use, may be used as a zero time point
+        @retval  - ticks of the first profiler use
+    **/
+    static u64 get_start_ticks() noexcept;
+
+    /**
+        @brief   Get ticks frequency
+        @details rdtsc frequency is measured against the steady clock since the first profiler use
+        @retval  - number of ticks per microsecond
+    **/
+    static double get_ticks_per_microsecond() noexcept;
+
+    /**
+        @brief Record a finished scope to the buffer of the current thread
+        @param event - finished scope
+    **/
+    static void record(const profiler_event& event) noexcept;
+
+    /**
+        @brief  Get recording pause flag of the current thread
+        @retval  - true if scopes of the current thread are not recorded
+    **/
+    static bool& get_thread_paused_flag() noexcept;
+
+    /**
+        @brief  Process recorded events of all threads and remove them from the buffers
+        @tparam consume_func_t - function type, void(u32 nThreadId, const profiler_event&)
+        @param  consumeFunc    - function processing an event
+        @retval                - number of events dropped because of full buffers since the previous call
+    **/
+    template<class consume_func_t>
+    static u64 consume_events(consume_func_t&& consumeFunc);
+
+    /**
+        @brief Enable aggregation of scopes to per-thread call trees
+    **/
+    static void start_call_tree() noexcept;
+
+    /**
+        @brief Disable aggregation of scopes to call trees, scopes started before the call are still aggregated
+    **/
+    static void stop_call_tree() noexcept;
+
+    /**
+        @brief  Check if aggregation of scopes to call trees is enabled
+        @retval  - true if aggregation of scopes to call trees is enabled
+    **/
+    static bool is_building_call_tree() noexcept;
+
+    /**
+        @brief Enter a scope of the call tree of the current thread
+        @param frame   - frame of the scope, must live until leave_call_tree()
+        @param pszName - scope name, same names are merged
+    **/
+    static void enter_call_tree(details::profiler_call_tree_frame& frame, const char* pszName) noexcept;
+
+    /**
+        @brief Leave a scope of the call tree of the current thread
+        @param frame     - frame of the scope
+        @param nEndTicks - end ticks of the scope
+    **/
+    static void leave_call_tree(details::profiler_call_tree_frame& frame, u64 nEndTicks) noexcept;
+
+    /**
+        @brief   Merge call trees of all threads, including finished ones
+        @details Scopes are merged by the path of their names, root children are the outermost scopes
+        @param   bReset - reset counters of the thread trees, so the next call returns only new scopes
+        @retval         - merged call tree root
+    **/
+    static profiler_call_tree_node collect_call_tree(bool bReset = false);
+
+    /**
+        @brief   Count an allocation in the innermost call tree scope of the current thread
+        @details Called by the allocation tracker, doesn't allocate itself.
+                 Allocations outside of scopes are counted in the call tree root
+        @param   nBytes - allocation size
+    **/
+    static void record_allocation(size_t nBytes) noexcept;
+
+    /**
+        @brief Count a deallocation in the innermost call tree scope of the current thread
+    **/
+    static void record_deallocation() noexcept;
+
+private:
+    /**
+        @brief  Get list head of buffers of all threads
+        @retval  - buffers list head, buffers are never deleted and are reused by new threads
+    **/
+    static std::atomic<details::profiler_thread_buffer*>& get_thread_buffers() noexcept;
+
+    /**
+        @brief  Get buffer of the current thread, create it if there is none
+        @retval  - buffer of the current thread or nullptr if it can't be allocated
+    **/
+    static details::profiler_thread_buffer* get_thread_buffer() noexcept;
+
+    /**
+        @brief  Get list head of call trees of all threads
+        @retval  - call trees list head, trees are never deleted and are reused by new threads
+    **/
+    static std::atomic<details::profiler_thread_call_tree*>& get_thread_call_trees() noexcept;
+
+    /**
+        @brief  Get call tree of the current thread, create it if there is none
+        @retval  - call tree of the current thread or nullptr if it can't be allocated
+    **/
+    static details::profiler_thread_call_tree* get_thread_call_tree() noexcept;
+
+    /**
+        @brief  Get call tree of the current thread without creating it
+        @retval  - call tree of the current thread or nullptr if there is none yet
+    **/
+    static details::profiler_thread_call_tree*& get_existing_thread_call_tree() noexcept;
+
+    /**
+        @brief  Get recording flag
+        @retval  - recording flag
+    **/
+    static std::atomic<bool>& get_recording_flag() noexcept;
+
+    /**
+        @brief  Get call tree aggregation flag
+        @retval  - call tree aggregation flag
+    **/
+    static std::atomic<bool>& get_call_tree_flag() noexcept;
+
+    /**
+        @brief  Get ticks and time of the first profiler use
+        @retval  - ticks and time of the first profiler use
+    **/
+    static const start_point& get_start_point() noexcept;
+};
+
+/**
+
+    @class   profiler_thread_pause
+    @brief   RAII object which stops recording of the current thread scopes for its lifetime
+    @details Used by the exporters, so they don't record their own scopes while consuming events
+    @author  Khrapov
+    @date    17.10.2026
+
+**/
+class profiler_thread_pause
+{
+public:
+    QX_NONCOPYMOVABLE(profiler_thread_pause);
+
+    /**
+        @brief profiler_thread_pause object constructor
+    **/
+    profiler_thread_pause() noexcept;
+
+    /**
+        @brief profiler_thread_pause object destructor
+    **/
+    ~profiler_thread_pause() noexcept;
+
+private:
+    bool m_bWasPaused = false;
+};
+
+/**
+
+    @class   profiler_scope
+    @brief   RAII perf scope which records its duration to the profiler
+    @author  Khrapov
+    @date    17.10.2026
+
+**/
+class profiler_scope
+{
+public:
+    QX_NONCOPYMOVABLE(profiler_scope);
+
+    /**
+        @brief profiler_scope object constructor
+        @param pszFunction - function name, used as the scope name
+    **/
+    explicit profiler_scope(const char* pszFunction) noexcept;
+
+    /**
+        @brief profiler_scope object constructor
+        @param pszFunction - function name
+        @param pszName     - scope name
+    **/
+    profiler_scope(const char* pszFunction, const char* pszName) noexcept;
+
+    /**
+        @brief profiler_scope object constructor
+        @param pszFunction - function name, used as the scope name
+        @param category    - scope category, must outlive the exported events
+    **/
+    profiler_scope(const char* pszFunction, const category& category) noexcept;
+
+    /**
+        @brief profiler_scope object constructor
+        @param pszFunction - function name
+        @param category    - scope category, must outlive the exported events
+        @param pszName     - scope name
+    **/
+    profiler_scope(const char* pszFunction, const category& category, const char* pszName) noexcept;
+
+    /**
+        @brief profiler_scope object destructor
+    **/
+    ~profiler_scope() noexcept;
+
+private:
+    profiler_event                    m_Event;
+    details::profiler_call_tree_frame m_CallTreeFrame;
+};
+
+} // namespace qx
+
+#include <qx/profiler/profiler.inl>
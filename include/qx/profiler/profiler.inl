@@ -0,0 +1,542 @@
+/**
+
+    @file      profiler.inl
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+
+namespace qx
+{
+
+namespace details
+{
+
+inline profiler_thread_buffer::profiler_thread_buffer(
+    std::unique_ptr<profiler_event[]> pEvents,
+    size_t                            nCapacity,
+    u32                               nThreadId) noexcept
+    : m_pEvents(std::move(pEvents))
+    , m_nMask(nCapacity - 1)
+    , m_nThreadId(nThreadId)
+{
+}
+
+inline bool profiler_thread_buffer::try_push(const profiler_event& event) noexcept
+{
+    const size_t nWritePos = m_nWritePos.load(std::memory_order_relaxed);
+    if (nWritePos - m_nReadPos.load(std::memory_order_acquire) > m_nMask)
+    {
+        m_nDroppedEvents.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    m_pEvents[nWritePos & m_nMask] = event;
+    m_nWritePos.store(nWritePos + 1, std::memory_order_release);
+    return true;
+}
+
+template<class consume_func_t>
+inline void profiler_thread_buffer::consume_all(consume_func_t&& consumeFunc)
+{
+    size_t       nReadPos  = m_nReadPos.load(std::memory_order_relaxed);
+    const size_t nWritePos = m_nWritePos.load(std::memory_order_acquire);
+
+    for (; nReadPos != nWritePos; ++nReadPos)
+        consumeFunc(m_pEvents[nReadPos & m_nMask]);
+
+    m_nReadPos.store(nReadPos, std::memory_order_release);
+}
+
+inline bool profiler_thread_buffer::empty() const noexcept
+{
+    return m_nReadPos.load(std::memory_order_acquire) == m_nWritePos.load(std::memory_order_acquire);
+}
+
+inline u32 profiler_thread_buffer::get_thread_id() const noexcept
+{
+    return m_nThreadId.load(std::memory_order_relaxed);
+}
+
+inline u64 profiler_thread_buffer::take_dropped_events_count() noexcept
+{
+    return m_nDroppedEvents.exchange(0, std::memory_order_relaxed);
+}
+
+inline void profiler_thread_buffer::reuse(u32 nThreadId) noexcept
+{
+    m_nThreadId.store(nThreadId, std::memory_order_relaxed);
+}
+
+inline profiler_thread_call_tree::profiler_thread_call_tree(std::unique_ptr<node[]> pNodes, u32 nCapacity) noexcept
+    : m_pNodes(std::move(pNodes))
+    , m_nCapacity(nCapacity)
+{
+}
+
+inline bool profiler_thread_call_tree::enter(profiler_call_tree_frame& frame, const char* pszName) noexcept
+{
+    const u32 nParent = m_pCurrentFrame ? m_pCurrentFrame->nNode : 0;
+
+    u32 nNode = m_pNodes[nParent].nFirstChild;
+    while (nNode != profiler_call_tree_frame::k_nInvalidNode && m_pNodes[nNode].pszName != pszName)
+        nNode = m_pNodes[nNode].nNextSibling;
+
+    if (nNode == profiler_call_tree_frame::k_nInvalidNode)
+    {
+        nNode = m_nNodes.load(std::memory_order_relaxed);
+        if (nNode == m_nCapacity)
+            return false;
+
+        node& newNode        = m_pNodes[nNode];
+        newNode.pszName      = pszName;
+        newNode.nParent      = nParent;
+        newNode.nNextSibling = m_pNodes[nParent].nFirstChild;
+
+        m_pNodes[nParent].nFirstChild = nNode;
+        m_nNodes.store(nNode + 1, std::memory_order_release);
+    }
+
+    frame.nNode     = nNode;
+    frame.pParent   = m_pCurrentFrame;
+    m_pCurrentFrame = &frame;
+
+    return true;
+}
+
+inline void profiler_thread_call_tree::leave(profiler_call_tree_frame& frame, u64 nEndTicks) noexcept
+{
+    const u64 nTicks = nEndTicks - frame.nBeginTicks;
+
+    node& currentNode = m_pNodes[frame.nNode];
+    currentNode.nCalls.fetch_add(1, std::memory_order_relaxed);
+    currentNode.nInclusiveTicks.fetch_add(nTicks, std::memory_order_relaxed);
+    currentNode.nExclusiveTicks.fetch_add(nTicks - std::min(frame.nChildTicks, nTicks), std::memory_order_relaxed);
+
+    if (frame.pParent)
+        frame.pParent->nChildTicks += nTicks;
+
+    m_pCurrentFrame = frame.pParent;
+}
+
+inline void profiler_thread_call_tree::record_allocation(size_t nBytes) noexcept
+{
+    node& currentNode = m_pNodes[m_pCurrentFrame ? m_pCurrentFrame->nNode : 0];
+    currentNode.nAllocations.fetch_add(1, std::memory_order_relaxed);
+    currentNode.nAllocatedBytes.fetch_add(nBytes, std::memory_order_relaxed);
+}
+
+inline void profiler_thread_call_tree::record_deallocation() noexcept
+{
+    m_pNodes[m_pCurrentFrame ? m_pCurrentFrame->nNode : 0].nDeallocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+template<class node_func_t>
+inline void profiler_thread_call_tree::for_each_node(node_func_t&& nodeFunc)
+{
+    const u32 nNodes = m_nNodes.load(std::memory_order_acquire);
+    for (u32 i = 0; i < nNodes; ++i)
+        nodeFunc(i, m_pNodes[i]);
+}
+
+inline bool profiler_thread_call_tree::empty() const noexcept
+{
+    return !m_pCurrentFrame;
+}
+
+} // namespace details
+
+inline void profiler::start() noexcept
+{
+    get_start_point();
+    get_recording_flag().store(true, std::memory_order_relaxed);
+}
+
+inline void profiler::stop() noexcept
+{
+    get_recording_flag().store(false, std::memory_order_relaxed);
+}
+
+inline bool profiler::is_recording() noexcept
+{
+    return get_recording_flag().load(std::memory_order_relaxed);
+}
+
+inline u64 profiler::get_ticks() noexcept
+{
+#if _QX_PROFILER_RDTSC
+    return __rdtsc();
+#else
+    return static_cast<u64>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now().time_since_epoch()).count());
+#endif
+}
+
+inline u64 profiler::get_start_ticks() noexcept
+{
+    return get_start_point().nTicks;
+}
+
+inline double profiler::get_ticks_per_microsecond() noexcept
+{
+#if _QX_PROFILER_RDTSC
+    const start_point& startPoint = get_start_point();
+
+    // a short interval gives an inaccurate frequency
+    constexpr auto k_MinInterval = std::chrono::milliseconds(10);
+    if (clock::now() - startPoint.time < k_MinInterval)
+        std::this_thread::sleep_until(startPoint.time + k_MinInterval);
+
+    const u64    nTicks        = get_ticks();
+    const double fMicroseconds = std::chrono::duration<double, std::micro>(clock::now() - startPoint.time).count();
+    return static_cast<double>(nTicks - startPoint.nTicks) / fMicroseconds;
+#else
+    return 1000.0;
+#endif
+}
+
+inline void profiler::record(const profiler_event& event) noexcept
+{
+    if (get_thread_paused_flag())
+        return;
+
+    if (details::profiler_thread_buffer* pBuffer = get_thread_buffer())
+        pBuffer->try_push(event);
+}
+
+inline bool& profiler::get_thread_paused_flag() noexcept
+{
+    thread_local bool bPaused = false;
+    return bPaused;
+}
+
+template<class consume_func_t>
+inline u64 profiler::consume_events(consume_func_t&& consumeFunc)
+{
+    u64 nDroppedEvents = 0;
+
+    for (details::profiler_thread_buffer* pBuffer = get_thread_buffers().load(std::memory_order_acquire);
+         pBuffer;
+         pBuffer = pBuffer->pNext)
+    {
+        const u32 nThreadId = pBuffer->get_thread_id();
+        pBuffer->consume_all(
+            [&consumeFunc, nThreadId](const profiler_event& event)
+            {
+                consumeFunc(nThreadId, event);
+            });
+
+        nDroppedEvents += pBuffer->take_dropped_events_count();
+    }
+
+    return nDroppedEvents;
+}
+
+inline void profiler::start_call_tree() noexcept
+{
+    get_call_tree_flag().store(true, std::memory_order_relaxed);
+}
+
+inline void profiler::stop_call_tree() noexcept
+{
+    get_call_tree_flag().store(false, std::memory_order_relaxed);
+}
+
+inline bool profiler::is_building_call_tree() noexcept
+{
+    return get_call_tree_flag().load(std::memory_order_relaxed);
+}
+
+inline void profiler::enter_call_tree(details::profiler_call_tree_frame& frame, const char* pszName) noexcept
+{
+    if (get_thread_paused_flag())
+        return;
+
+    details::profiler_thread_call_tree* pCallTree = get_thread_call_tree();
+    if (!pCallTree || !pCallTree->enter(frame, pszName))
+        return;
+
+    frame.nBeginTicks = get_ticks();
+}
+
+inline void profiler::leave_call_tree(details::profiler_call_tree_frame& frame, u64 nEndTicks) noexcept
+{
+    if (frame.nNode != details::profiler_call_tree_frame::k_nInvalidNode)
+        get_thread_call_tree()->leave(frame, nEndTicks);
+}
+
+inline profiler_call_tree_node profiler::collect_call_tree(bool bReset)
+{
+    using thread_call_tree = details::profiler_thread_call_tree;
+
+    auto read_counter = [bReset](std::atomic<u64>& nCounter)
+    {
+        return bReset ? nCounter.exchange(0, std::memory_order_relaxed) : nCounter.load(std::memory_order_relaxed);
+    };
+
+    profiler_call_tree_node              root;
+    std::vector<profiler_call_tree_node*> mergedNodes;
+
+    for (thread_call_tree* pCallTree = get_thread_call_trees().load(std::memory_order_acquire); pCallTree;
+         pCallTree = pCallTree->pNext)
+    {
+        mergedNodes.clear();
+
+        pCallTree->for_each_node(
+            [&](u32 nNode, thread_call_tree::node& node)
+            {
+                profiler_call_tree_node* pMergedNode = &root;
+                if (nNode != 0)
+                {
+                    // parents are always created before their children, so they are already merged
+                    auto& pChild = mergedNodes[node.nParent]->children[node.pszName];
+                    if (!pChild)
+                        pChild = std::make_unique<profiler_call_tree_node>();
+
+                    pMergedNode = pChild.get();
+                }
+
+                profiler_call_tree_node& mergedNode = *pMergedNode;
+
+                mergedNode.nCalls += read_counter(node.nCalls);
+                mergedNode.nInclusiveTicks += read_counter(node.nInclusiveTicks);
+                mergedNode.nExclusiveTicks += read_counter(node.nExclusiveTicks);
+                mergedNode.nAllocations += read_counter(node.nAllocations);
+                mergedNode.nAllocatedBytes += read_counter(node.nAllocatedBytes);
+                mergedNode.nDeallocations += read_counter(node.nDeallocations);
+                mergedNodes.push_back(&mergedNode);
+            });
+    }
+
+    return root;
+}
+
+inline void profiler::record_allocation(size_t nBytes) noexcept
+{
+    if (!is_building_call_tree() || get_thread_paused_flag())
+        return;
+
+    if (details::profiler_thread_call_tree* pCallTree = get_existing_thread_call_tree())
+        pCallTree->record_allocation(nBytes);
+}
+
+inline void profiler::record_deallocation() noexcept
+{
+    if (!is_building_call_tree() || get_thread_paused_flag())
+        return;
+
+    if (details::profiler_thread_call_tree* pCallTree = get_existing_thread_call_tree())
+        pCallTree->record_deallocation();
+}
+
+inline std::atomic<details::profiler_thread_buffer*>& profiler::get_thread_buffers() noexcept
+{
+    static std::atomic<details::profiler_thread_buffer*> pBuffers = nullptr;
+    return pBuffers;
+}
+
+inline details::profiler_thread_buffer* profiler::get_thread_buffer() noexcept
+{
+    struct thread_buffer
+    {
+        thread_buffer() noexcept
+        {
+            // events of the thread must not be earlier than the zero time point
+            get_start_point();
+
+            static std::atomic<u32> nLastThreadId = 0;
+            const u32               nThreadId     = nLastThreadId.fetch_add(1, std::memory_order_relaxed) + 1;
+
+            auto& pBuffers = get_thread_buffers();
+
+            // take a drained buffer of a finished thread first
+            for (details::profiler_thread_buffer* pFree = pBuffers.load(std::memory_order_acquire);
+                 pFree;
+                 pFree = pFree->pNext)
+            {
+                bool bInUse = false;
+                if (pFree->empty() && pFree->bInUse.compare_exchange_strong(bInUse, true, std::memory_order_acquire))
+                {
+                    pFree->reuse(nThreadId);
+                    pBuffer = pFree;
+                    return;
+                }
+            }
+
+            // the buffer is not an allocation of the scope which happened to push the first event
+            const profiler_thread_pause pause;
+
+            size_t nCapacity = 1;
+            while (nCapacity < QX_CONF_PROFILER_THREAD_BUFFER_SIZE)
+                nCapacity <<= 1;
+
+            std::unique_ptr<profiler_event[]> pEvents(new (std::nothrow) profiler_event[nCapacity]);
+            if (!pEvents)
+                return;
+
+            // buffers are never deleted, so the consumer may walk the list without locks
+            pBuffer = new (std::nothrow) details::profiler_thread_buffer(std::move(pEvents), nCapacity, nThreadId);
+            if (!pBuffer)
+                return;
+
+            pBuffer->pNext = pBuffers.load(std::memory_order_relaxed);
+            while (!pBuffers.compare_exchange_weak(pBuffer->pNext, pBuffer, std::memory_order_release))
+            {
+            }
+        }
+
+        ~thread_buffer()
+        {
+            if (pBuffer)
+                pBuffer->bInUse.store(false, std::memory_order_release);
+        }
+
+        details::profiler_thread_buffer* pBuffer = nullptr;
+    };
+
+    thread_local thread_buffer buffer;
+    return buffer.pBuffer;
+}
+
+inline std::atomic<details::profiler_thread_call_tree*>& profiler::get_thread_call_trees() noexcept
+{
+    static std::atomic<details::profiler_thread_call_tree*> pCallTrees = nullptr;
+    return pCallTrees;
+}
+
+inline details::profiler_thread_call_tree* profiler::get_thread_call_tree() noexcept
+{
+    struct thread_call_tree
+    {
+        thread_call_tree() noexcept
+        {
+            auto& pCallTrees = get_thread_call_trees();
+
+            // continue a tree of a finished thread first, its nodes are merged with other threads anyway
+            for (details::profiler_thread_call_tree* pFree = pCallTrees.load(std::memory_order_acquire); pFree;
+                 pFree = pFree->pNext)
+            {
+                bool bInUse = false;
+                if (pFree->empty() && pFree->bInUse.compare_exchange_strong(bInUse, true, std::memory_order_acquire))
+                {
+                    pCallTree                       = pFree;
+                    get_existing_thread_call_tree() = pCallTree;
+                    return;
+                }
+            }
+
+            constexpr u32 k_nCapacity = std::max<u32>(QX_CONF_PROFILER_CALL_TREE_SIZE, 1);
+
+            std::unique_ptr<details::profiler_thread_call_tree::node[]> pNodes(
+                new (std::nothrow) details::profiler_thread_call_tree::node[k_nCapacity]);
+            if (!pNodes)
+                return;
+
+            // trees are never deleted, so the collector may walk the list without locks
+            pCallTree = new (std::nothrow) details::profiler_thread_call_tree(std::move(pNodes), k_nCapacity);
+            if (!pCallTree)
+                return;
+
+            pCallTree->pNext = pCallTrees.load(std::memory_order_relaxed);
+            while (!pCallTrees.compare_exchange_weak(pCallTree->pNext, pCallTree, std::memory_order_release))
+            {
+            }
+
+            get_existing_thread_call_tree() = pCallTree;
+        }
+
+        ~thread_call_tree()
+        {
+            get_existing_thread_call_tree() = nullptr;
+
+            if (pCallTree)
+                pCallTree->bInUse.store(false, std::memory_order_release);
+        }
+
+        details::profiler_thread_call_tree* pCallTree = nullptr;
+    };
+
+    thread_local thread_call_tree callTree;
+    return callTree.pCallTree;
+}
+
+inline details::profiler_thread_call_tree*& profiler::get_existing_thread_call_tree() noexcept
+{
+    // trivially destructible, so it's safe to use from allocation functions at any time
+    thread_local details::profiler_thread_call_tree* pCallTree = nullptr;
+    return pCallTree;
+}
+
+inline const profiler::start_point& profiler::get_start_point() noexcept
+{
+    static const start_point startPoint { get_ticks(), clock::now() };
+    return startPoint;
+}
+
+inline std::atomic<bool>& profiler::get_recording_flag() noexcept
+{
+    static std::atomic<bool> bRecording = true;
+    return bRecording;
+}
+
+inline std::atomic<bool>& profiler::get_call_tree_flag() noexcept
+{
+    static std::atomic<bool> bBuildingCallTree = false;
+    return bBuildingCallTree;
+}
+
+inline profiler_thread_pause::profiler_thread_pause() noexcept
+    : m_bWasPaused(std::exchange(profiler::get_thread_paused_flag(), true))
+{
+}
+
+inline profiler_thread_pause::~profiler_thread_pause() noexcept
+{
+    profiler::get_thread_paused_flag() = m_bWasPaused;
+}
+
+inline profiler_scope::profiler_scope(const char* pszFunction) noexcept : profiler_scope(pszFunction, pszFunction)
+{
+}
+
+inline profiler_scope::profiler_scope([[maybe_unused]] const char* pszFunction, const char* pszName) noexcept
+{
+    if (profiler::is_building_call_tree())
+        profiler::enter_call_tree(m_CallTreeFrame, pszName);
+
+    if (!profiler::is_recording())
+        return;
+
+    m_Event.pszName     = pszName;
+    m_Event.nBeginTicks = profiler::get_ticks();
+}
+
+inline profiler_scope::profiler_scope(const char* pszFunction, const category& category) noexcept
+    : profiler_scope(pszFunction, category, pszFunction)
+{
+}
+
+inline profiler_scope::profiler_scope(const char* pszFunction, const category& category, const char* pszName) noexcept
+    : profiler_scope(pszFunction, pszName)
+{
+    m_Event.pCategory = &category;
+}
+
+inline profiler_scope::~profiler_scope() noexcept
+{
+    if (!m_Event.pszName && m_CallTreeFrame.nNode == details::profiler_call_tree_frame::k_nInvalidNode)
+        return;
+
+    const u64 nEndTicks = profiler::get_ticks();
+
+    if (m_Event.pszName)
+    {
+        m_Event.nEndTicks = nEndTicks;
+        profiler::record(m_Event);
+    }
+
+    profiler::leave_call_tree(m_CallTreeFrame, nEndTicks);
+}
+
+} // namespace qx
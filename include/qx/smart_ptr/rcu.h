@@ -0,0 +1,95 @@
+/**
+
+    @file      rcu.h
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+#pragma once
+
+#include <qx/internal/cache_line.h>
+#include <qx/macros/copyable_movable.h>
+#include <qx/macros/suppress_warnings.h>
+#include <qx/typedefs.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+
+namespace qx
+{
+
+namespace details
+{
+
+// the sequence is aligned to a cache line, so the struct is padded (C4324)
+QX_PUSH_SUPPRESS_MSVC_WARNINGS(4324);
+
+struct rcu_reader
+{
+    alignas(k_nCacheLineSize) std::atomic<u64> nSequence = 0; // odd while the thread is in a read section
+    std::atomic<bool> bInUse = true;
+    size_t            nDepth = 0; // nested read sections, owner thread only
+    rcu_reader*       pNext  = nullptr;
+};
+
+QX_POP_SUPPRESS_WARNINGS();
+
+/**
+    @brief  Get list head of readers of all threads
+    @retval  - readers list head, readers are never deleted and are reused by new threads
+**/
+std::atomic<rcu_reader*>& get_rcu_readers() noexcept;
+
+/**
+    @brief  Get reader of the current thread, register it if there is none
+    @retval  - reader of the current thread
+**/
+rcu_reader& get_thread_rcu_reader();
+
+} // namespace details
+
+/**
+
+    @class   rcu_read_guard
+    @brief   Read section of the process wide read-copy-update domain
+    @details Data published with an atomic pointer and replaced by a writer is not deleted
+             until all read sections which could see it are finished.
+             Entering a section takes no lock and touches no shared reference counter:
+             it only updates a sequence number owned by the current thread.
+             Sections may be nested
+    @author  Khrapov
+    @date    17.10.2026
+
+**/
+class rcu_read_guard
+{
+public:
+    QX_NONCOPYMOVABLE(rcu_read_guard);
+
+    /**
+        @brief rcu_read_guard object constructor
+    **/
+    rcu_read_guard();
+
+    /**
+        @brief rcu_read_guard object destructor
+    **/
+    ~rcu_read_guard() noexcept;
+
+private:
+    details::rcu_reader& m_Reader;
+};
+
+/**
+    @brief   Wait for all read sections started before the call
+    @details Call after replacing the published pointer and before deleting the old data.
+             Must not be called inside a read section of the same thread
+**/
+void rcu_synchronize() noexcept;
+
+} // namespace qx
+
+#include <qx/smart_ptr/rcu.inl>
@@ -0,0 +1,106 @@
+/**
+
+    @file      rcu.inl
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+
+namespace qx
+{
+
+namespace details
+{
+
+inline std::atomic<rcu_reader*>& get_rcu_readers() noexcept
+{
+    static std::atomic<rcu_reader*> pReaders = nullptr;
+    return pReaders;
+}
+
+inline rcu_reader& get_thread_rcu_reader()
+{
+    struct thread_reader
+    {
+        thread_reader()
+        {
+            auto& pReaders = get_rcu_readers();
+
+            // take a reader of a finished thread first
+            for (rcu_reader* pFree = pReaders.load(std::memory_order_acquire); pFree; pFree = pFree->pNext)
+            {
+                bool bInUse = false;
+                if (pFree->bInUse.compare_exchange_strong(bInUse, true, std::memory_order_acquire))
+                {
+                    pReader = pFree;
+                    return;
+                }
+            }
+
+            // readers are never deleted, so synchronizing threads may walk the list without locks
+            pReader        = new rcu_reader;
+            pReader->pNext = pReaders.load(std::memory_order_relaxed);
+            while (!pReaders.compare_exchange_weak(pReader->pNext, pReader, std::memory_order_release))
+            {
+            }
+        }
+
+        ~thread_reader()
+        {
+            pReader->bInUse.store(false, std::memory_order_release);
+        }
+
+        rcu_reader* pReader = nullptr;
+    };
+
+    thread_local thread_reader reader;
+    return *reader.pReader;
+}
+
+} // namespace details
+
+inline rcu_read_guard::rcu_read_guard() : m_Reader(details::get_thread_rcu_reader())
+{
+    if (m_Reader.nDepth++ == 0)
+    {
+        m_Reader.nSequence.store(m_Reader.nSequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        // the sequence must be visible before any load of the protected data
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+}
+
+inline rcu_read_guard::~rcu_read_guard() noexcept
+{
+    if (--m_Reader.nDepth == 0)
+        m_Reader.nSequence.store(m_Reader.nSequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+inline void rcu_synchronize() noexcept
+{
+    // pairs with the fence of the readers: either the reader sees the new data
+    // or the writer sees the reader in the section
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    for (const details::rcu_reader* pReader = details::get_rcu_readers().load(std::memory_order_acquire);
+         pReader;
+         pReader = pReader->pNext)
+    {
+        const u64 nSequence = pReader->nSequence.load(std::memory_order_acquire);
+        if (nSequence % 2 == 0)
+            continue;
+
+        // sections started after the fence see the new data, so wait only for the current one.
+        // A preempted reader needs the cpu, so sleep if yielding doesn't help
+        for (size_t nAttempt = 0; pReader->nSequence.load(std::memory_order_acquire) == nSequence; ++nAttempt)
+        {
+            if (nAttempt < 64)
+                std::this_thread::yield();
+            else
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+}
+
+} // namespace qx
@@ -8,15 +8,126 @@
 **/
 #pragma once
 
+#include <qx/internal/json.h>
+#include <qx/macros/config.h>
+#include <qx/macros/copyable_movable.h>
+#include <qx/typedefs.h>
+
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <cmath>
+#include <ctime>
+#include <format>
+#include <iterator>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define _QX_BENCHMARK_RDTSC 1
+    #if QX_MSVC
+        #include <intrin.h>
+    #else
+        #include <x86intrin.h>
+    #endif
+#else
+    #define _QX_BENCHMARK_RDTSC 0
+#endif
+
+#if QX_LINUX
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
 
 namespace qx
 {
 
+/**
+
+    @struct  benchmark_options
+    @brief   Options of a benchmark harness run
+    @author  Khrapov
+    @date    17.10.2026
+
+**/
+struct benchmark_options
+{
+    // number of warmup iterations, 0 - run warmup for warmupTime
+    size_t                   nWarmupIterations = 0;
+    std::chrono::nanoseconds warmupTime        = std::chrono::milliseconds(50);
+
+    // number of iterations in one sample, 0 - calibrate so that one sample takes about sampleTime
+    size_t                   nIterationsPerSample = 0;
+    std::chrono::nanoseconds sampleTime           = std::chrono::milliseconds(5);
+    size_t                   nSamples             = 30;
+
+    // samples farther than fOutlierThreshold scaled median absolute deviations from the median are rejected,
+    // 0 - no rejection
+    double fOutlierThreshold = 3.5;
+
+    // count cycles with rdtsc (x86 only)
+    bool bMeasureCycles = false;
+
+    // count hardware events with perf_event_open (Linux only, may be forbidden by perf_event_paranoid)
+    bool bMeasureHardwareCounters = false;
+};
+
+/**
+
+    @struct  benchmark_hardware_counters
+    @brief   Hardware event counts per iteration
+    @author  Khrapov
+    @date    17.10.2026
+
+**/
+struct benchmark_hardware_counters
+{
+    std::optional<double> optCycles;
+    std::optional<double> optInstructions;
+    std::optional<double> optCacheMisses;
+    std::optional<double> optBranchMisses;
+};
+
+/**
+
+    @struct  benchmark_result
+    @brief   Result of a benchmark harness run
+    @details All times are in nanoseconds per iteration, statistics are calculated without rejected outliers
+    @author  Khrapov
+    @date    17.10.2026
+
+**/
+struct benchmark_result
+{
+    std::string         sName;
+    size_t              nIterationsPerSample = 0;
+    std::vector<double> samples;
+    size_t              nOutliers = 0;
+
+    double fMin    = 0.0;
+    double fMedian = 0.0;
+    double fMean   = 0.0;
+    double fStdDev = 0.0;
+    double fP90    = 0.0;
+    double fP99    = 0.0;
+
+    // rdtsc ticks per iteration
+    std::optional<double>                      optCycles;
+    std::optional<benchmark_hardware_counters> optHardwareCounters;
+};
+
 /**
 
     @class   benchmark
     @brief   Benchmark class
+    @details Object may be used as a simple stopwatch with start() and end()
+             or as a statistical harness with run()
     @author  Khrapov
     @date    2.02.2020
 
@@ -45,11 +156,105 @@ public:
     **/
     double last() const;
 
+    /**
+        @brief  Measure function: warmup, calibrate iterations count, collect samples and calculate statistics
+        @tparam func_t  - function type, void()
+        @param  svName  - benchmark name
+        @param  func    - function to measure, one call is one iteration
+        @param  options - run options
+        @retval         - benchmark result
+    **/
+    template<class func_t>
+    static benchmark_result run(std::string_view svName, func_t&& func, const benchmark_options& options = {});
+
+    /**
+        @brief Calculate statistics of result samples with outliers rejection
+        @param result            - benchmark result with samples
+        @param fOutlierThreshold - outlier threshold in scaled median absolute deviations, 0 - no rejection
+    **/
+    static void calculate_statistics(benchmark_result& result, double fOutlierThreshold);
+
+    /**
+        @brief  Prevent compiler from optimizing out value calculation
+        @tparam T     - value type
+        @param  value - value to keep
+    **/
+    template<class T>
+    static void do_not_optimize(const T& value) noexcept;
+
 private:
     time_point m_Start;
     duration   m_LastDuration = duration(0);
 };
 
+/**
+    @brief Write benchmark results as JSON
+    @param stream  - output stream
+    @param results - benchmark results
+**/
+void export_benchmark_json(std::ostream& stream, std::span<const benchmark_result> results);
+
+namespace details
+{
+
+/**
+
+    @class   benchmark_perf_counters
+    @brief   Group of perf_event_open hardware counters of the current thread
+    @details Does nothing if hardware counters are not available
+    @author  Khrapov
+    @date    17.10.2026
+
+**/
+class benchmark_perf_counters
+{
+public:
+    enum class event
+    {
+        cycles,
+        instructions,
+        cache_misses,
+        branch_misses,
+    };
+
+    static constexpr size_t k_nEvents = 4;
+
+    using values = std::array<std::optional<u64>, k_nEvents>;
+
+public:
+    QX_NONCOPYMOVABLE(benchmark_perf_counters);
+
+    benchmark_perf_counters();
+    ~benchmark_perf_counters();
+
+    /**
+        @brief  Check if at least one counter is opened
+        @retval  - true if at least one counter is opened
+    **/
+    bool is_valid() const noexcept;
+
+    /**
+        @brief Reset and enable counters
+    **/
+    void start() noexcept;
+
+    /**
+        @brief  Disable counters and read values
+        @retval  - counters values since start, empty for unavailable counters
+    **/
+    values stop() noexcept;
+
+private:
+#if QX_LINUX
+    int                           m_nGroupFd = -1;
+    std::array<int, k_nEvents>    m_Fds;
+    std::array<size_t, k_nEvents> m_GroupIndices;
+    size_t                        m_nOpened = 0;
+#endif
+};
+
+} // namespace details
+
 } // namespace qx
 
 #include <qx/stat/benchmark.inl>
@@ -10,6 +10,143 @@
 namespace qx
 {
 
+namespace details
+{
+
+/**
+    @brief  Get percentile of sorted values with linear interpolation
+    @param  sortedValues - sorted values, not empty
+    @param  fPercentile  - percentile in [0, 1]
+    @retval              - percentile value
+**/
+inline double get_sorted_percentile(std::span<const double> sortedValues, double fPercentile)
+{
+    const double fRank  = fPercentile * static_cast<double>(sortedValues.size() - 1);
+    const size_t nLower = static_cast<size_t>(fRank);
+    const size_t nUpper = std::min(nLower + 1, sortedValues.size() - 1);
+
+    return sortedValues[nLower] + (sortedValues[nUpper] - sortedValues[nLower]) * (fRank - static_cast<double>(nLower));
+}
+
+inline u64 read_benchmark_cycles() noexcept
+{
+#if _QX_BENCHMARK_RDTSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+#if QX_LINUX
+
+inline benchmark_perf_counters::benchmark_perf_counters()
+{
+    constexpr std::array<u64, k_nEvents> eventConfigs = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES,
+    };
+
+    m_Fds.fill(-1);
+
+    for (size_t i = 0; i < k_nEvents; ++i)
+    {
+        perf_event_attr attr {};
+        attr.type           = PERF_TYPE_HARDWARE;
+        attr.size           = sizeof(perf_event_attr);
+        attr.config         = eventConfigs[i];
+        attr.disabled       = m_nGroupFd == -1 ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+        attr.read_format    = PERF_FORMAT_GROUP;
+
+        const int nFd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, m_nGroupFd, 0));
+        if (nFd == -1)
+            continue;
+
+        if (m_nGroupFd == -1)
+            m_nGroupFd = nFd;
+
+        m_Fds[i]          = nFd;
+        m_GroupIndices[i] = m_nOpened++;
+    }
+}
+
+inline benchmark_perf_counters::~benchmark_perf_counters()
+{
+    for (const int nFd : m_Fds)
+    {
+        if (nFd != -1)
+            close(nFd);
+    }
+}
+
+inline bool benchmark_perf_counters::is_valid() const noexcept
+{
+    return m_nGroupFd != -1;
+}
+
+inline void benchmark_perf_counters::start() noexcept
+{
+    if (!is_valid())
+        return;
+
+    ioctl(m_nGroupFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(m_nGroupFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+inline benchmark_perf_counters::values benchmark_perf_counters::stop() noexcept
+{
+    values result;
+
+    if (!is_valid())
+        return result;
+
+    ioctl(m_nGroupFd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    // PERF_FORMAT_GROUP layout: number of counters followed by their values
+    std::array<u64, k_nEvents + 1> buffer {};
+    if (read(m_nGroupFd, buffer.data(), sizeof(buffer)) < static_cast<ssize_t>(sizeof(u64) * (m_nOpened + 1)))
+        return result;
+
+    for (size_t i = 0; i < k_nEvents; ++i)
+    {
+        if (m_Fds[i] != -1)
+            result[i] = buffer[1 + m_GroupIndices[i]];
+    }
+
+    return result;
+}
+
+#else
+
+inline benchmark_perf_counters::benchmark_perf_counters()
+{
+}
+
+inline benchmark_perf_counters::~benchmark_perf_counters()
+{
+}
+
+inline bool benchmark_perf_counters::is_valid() const noexcept
+{
+    return false;
+}
+
+inline void benchmark_perf_counters::start() noexcept
+{
+}
+
+inline benchmark_perf_counters::values benchmark_perf_counters::stop() noexcept
+{
+    return {};
+}
+
+#endif
+
+} // namespace details
+
 inline void benchmark::start()
 {
     m_Start = clock::now();
@@ -26,4 +163,258 @@ inline double benchmark::last() const
     return static_cast<double>(m_LastDuration.count()) / 1e9;
 }
 
+template<class func_t>
+inline benchmark_result benchmark::run(std::string_view svName, func_t&& func, const benchmark_options& options)
+{
+    auto run_iterations = [&func](size_t nIterations)
+    {
+        const time_point start = clock::now();
+
+        for (size_t i = 0; i < nIterations; ++i)
+            func();
+
+        return std::chrono::duration_cast<duration>(clock::now() - start);
+    };
+
+    benchmark_result result;
+    result.sName = svName;
+
+    if (options.nWarmupIterations > 0)
+    {
+        run_iterations(options.nWarmupIterations);
+    }
+    else
+    {
+        const time_point warmupStart = clock::now();
+        do
+        {
+            run_iterations(1);
+        } while (clock::now() - warmupStart < options.warmupTime);
+    }
+
+    result.nIterationsPerSample = options.nIterationsPerSample;
+    if (result.nIterationsPerSample == 0)
+    {
+        // grow the iterations count until the measurement is long enough to be precise, then extrapolate
+        constexpr size_t k_nMaxIterations = size_t(1) << 30;
+
+        const duration minCalibrationTime = std::max(options.sampleTime / 8, duration(1));
+
+        size_t   nIterations = 1;
+        duration elapsed     = run_iterations(nIterations);
+        while (elapsed < minCalibrationTime && nIterations < k_nMaxIterations)
+        {
+            nIterations *= 2;
+            elapsed = run_iterations(nIterations);
+        }
+
+        const double fIterations = static_cast<double>(nIterations) * static_cast<double>(options.sampleTime.count())
+                                   / static_cast<double>(std::max<duration::rep>(elapsed.count(), 1));
+
+        result.nIterationsPerSample = static_cast<size_t>(std::clamp(fIterations, 1.0, double(k_nMaxIterations)));
+    }
+
+    std::optional<details::benchmark_perf_counters> optPerfCounters;
+    if (options.bMeasureHardwareCounters)
+        optPerfCounters.emplace();
+
+    result.samples.reserve(options.nSamples);
+
+    constexpr size_t k_nEvents = details::benchmark_perf_counters::k_nEvents;
+
+    u64                         nTotalCycles = 0;
+    std::array<u64, k_nEvents>  totalEvents {};
+    std::array<bool, k_nEvents> eventsValid {};
+    eventsValid.fill(true);
+
+    for (size_t i = 0; i < std::max<size_t>(options.nSamples, 1); ++i)
+    {
+        if (optPerfCounters)
+            optPerfCounters->start();
+
+        const u64      nStartCycles = options.bMeasureCycles ? details::read_benchmark_cycles() : 0;
+        const duration elapsed      = run_iterations(result.nIterationsPerSample);
+        const u64      nEndCycles   = options.bMeasureCycles ? details::read_benchmark_cycles() : 0;
+
+        if (optPerfCounters)
+        {
+            const auto events = optPerfCounters->stop();
+            for (size_t j = 0; j < events.size(); ++j)
+            {
+                if (events[j])
+                    totalEvents[j] += *events[j];
+                else
+                    eventsValid[j] = false;
+            }
+        }
+
+        nTotalCycles += nEndCycles - nStartCycles;
+        result.samples.push_back(
+            static_cast<double>(elapsed.count()) / static_cast<double>(result.nIterationsPerSample));
+    }
+
+    const double fTotalIterations = static_cast<double>(result.nIterationsPerSample * result.samples.size());
+
+    if (options.bMeasureCycles && _QX_BENCHMARK_RDTSC)
+        result.optCycles = static_cast<double>(nTotalCycles) / fTotalIterations;
+
+    if (optPerfCounters && optPerfCounters->is_valid())
+    {
+        auto get_counter = [&](details::benchmark_perf_counters::event eEvent) -> std::optional<double>
+        {
+            const size_t nEvent = static_cast<size_t>(eEvent);
+            if (!eventsValid[nEvent])
+                return std::nullopt;
+
+            return static_cast<double>(totalEvents[nEvent]) / fTotalIterations;
+        };
+
+        using event = details::benchmark_perf_counters::event;
+
+        result.optHardwareCounters = benchmark_hardware_counters {
+            .optCycles       = get_counter(event::cycles),
+            .optInstructions = get_counter(event::instructions),
+            .optCacheMisses  = get_counter(event::cache_misses),
+            .optBranchMisses = get_counter(event::branch_misses),
+        };
+    }
+
+    calculate_statistics(result, options.fOutlierThreshold);
+
+    return result;
+}
+
+inline void benchmark::calculate_statistics(benchmark_result& result, double fOutlierThreshold)
+{
+    result.nOutliers = 0;
+
+    if (result.samples.empty())
+        return;
+
+    std::vector<double> sorted = result.samples;
+    std::ranges::sort(sorted);
+
+    if (fOutlierThreshold > 0.0)
+    {
+        const double fMedian = details::get_sorted_percentile(sorted, 0.5);
+
+        std::vector<double> deviations;
+        deviations.reserve(sorted.size());
+        for (const double fSample : sorted)
+            deviations.push_back(std::abs(fSample - fMedian));
+
+        std::ranges::sort(deviations);
+
+        // 1.4826 * MAD estimates the standard deviation of normally distributed samples
+        const double fMaxDeviation = fOutlierThreshold * 1.4826 * details::get_sorted_percentile(deviations, 0.5);
+
+        if (fMaxDeviation > 0.0)
+        {
+            const auto removed = std::ranges::remove_if(
+                sorted,
+                [fMedian, fMaxDeviation](double fSample)
+                {
+                    return std::abs(fSample - fMedian) > fMaxDeviation;
+                });
+
+            result.nOutliers = static_cast<size_t>(removed.size());
+            sorted.erase(removed.begin(), removed.end());
+        }
+    }
+
+    double fSum = 0.0;
+    for (const double fSample : sorted)
+        fSum += fSample;
+
+    result.fMean = fSum / static_cast<double>(sorted.size());
+
+    double fSquaredDeviationsSum = 0.0;
+    for (const double fSample : sorted)
+        fSquaredDeviationsSum += (fSample - result.fMean) * (fSample - result.fMean);
+
+    result.fStdDev =
+        sorted.size() > 1 ? std::sqrt(fSquaredDeviationsSum / static_cast<double>(sorted.size() - 1)) : 0.0;
+
+    result.fMin    = sorted.front();
+    result.fMedian = details::get_sorted_percentile(sorted, 0.5);
+    result.fP90    = details::get_sorted_percentile(sorted, 0.9);
+    result.fP99    = details::get_sorted_percentile(sorted, 0.99);
+}
+
+template<class T>
+inline void benchmark::do_not_optimize(const T& value) noexcept
+{
+#if QX_MSVC
+    static_cast<void>(*reinterpret_cast<const volatile char*>(&value));
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+inline void export_benchmark_json(std::ostream& stream, std::span<const benchmark_result> results)
+{
+    auto append_optional = [](std::string& sJson, std::string_view svKey, const std::optional<double>& optValue)
+    {
+        if (optValue)
+            std::format_to(std::back_inserter(sJson), ",\"{}\":{:.4f}", svKey, *optValue);
+    };
+
+    std::string sJson;
+
+    std::format_to(
+        std::back_inserter(sJson),
+        "{{\"context\":{{\"timestamp\":{},\"build\":\"{}\",\"compiler\":\"{}\"}},\"benchmarks\":[",
+        static_cast<long long>(std::time(nullptr)),
+        QX_DEBUG ? "debug" : "release",
+        QX_MSVC ? "msvc" : QX_CLANG ? "clang" : QX_GNU ? "gcc" : "unknown");
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const benchmark_result& result = results[i];
+
+        sJson += i > 0 ? ",\n{\"name\":\"" : "\n{\"name\":\"";
+        details::append_json_escaped(sJson, result.sName);
+
+        std::format_to(
+            std::back_inserter(sJson),
+            "\",\"iterations\":{},\"samples\":{},\"outliers\":{},\"time_unit\":\"ns\",\"min\":{:.4f},"
+            "\"median\":{:.4f},\"mean\":{:.4f},\"stddev\":{:.4f},\"p90\":{:.4f},\"p99\":{:.4f}",
+            result.nIterationsPerSample,
+            result.samples.size(),
+            result.nOutliers,
+            result.fMin,
+            result.fMedian,
+            result.fMean,
+            result.fStdDev,
+            result.fP90,
+            result.fP99);
+
+        append_optional(sJson, "cycles", result.optCycles);
+
+        if (result.optHardwareCounters)
+        {
+            const benchmark_hardware_counters& counters = *result.optHardwareCounters;
+
+            std::string sCounters;
+            append_optional(sCounters, "cycles", counters.optCycles);
+            append_optional(sCounters, "instructions", counters.optInstructions);
+            append_optional(sCounters, "cache_misses", counters.optCacheMisses);
+            append_optional(sCounters, "branch_misses", counters.optBranchMisses);
+
+            // skip the leading comma of the first counter
+            std::format_to(
+                std::back_inserter(sJson),
+                ",\"hardware_counters\":{{{}}}",
+                std::string_view(sCounters).substr(std::min<size_t>(sCounters.size(), 1)));
+        }
+
+        sJson += '}';
+    }
+
+    sJson += "\n]}\n";
+
+    stream.write(sJson.data(), static_cast<std::streamsize>(sJson.size()));
+}
+
 } // namespace qx
@@ -0,0 +1,371 @@
+/**
+
+    @file      metrics.h
+    @brief     Category-keyed metrics: counters, gauges and log-bucketed histograms
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+#pragma once
+
+#include <qx/category.h>
+#include <qx/containers/string/string_converters.h>
+#include <qx/internal/json.h>
+#include <qx/macros/copyable_movable.h>
+#include <qx/typedefs.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifndef QX_CONF_METRICS_HISTOGRAM_SUB_BUCKET_BITS
+    // each power of 2 range of histogram values is divided into 2^N buckets, relative error is 2^-N
+    #define QX_CONF_METRICS_HISTOGRAM_SUB_BUCKET_BITS 3
+#endif
+
+namespace qx
+{
+
+/**
+    @enum  metric_type
+    @brief Metric type
+**/
+enum class metric_type : u8
+{
+    counter,
+    gauge,
+    histogram,
+};
+
+/**
+
+    @class   metric_histogram_layout
+    @brief   HDR-style buckets: values below 2^(N+1) have own buckets,
+             every next power of 2 range is divided into 2^N buckets of the same width
+    @author  Khrapov
+    @date    17.10.2026
+
+**/
+class metric_histogram_layout
+{
+public:
+    static constexpr size_t k_nSubBucketBits = QX_CONF_METRICS_HISTOGRAM_SUB_BUCKET_BITS;
+    static constexpr size_t k_nSubBuckets    = size_t(1) << k_nSubBucketBits;
+    static constexpr size_t k_nBuckets       = (64 - k_nSubBucketBits + 1) * k_nSubBuckets;
+
+    /**
+        @brief  Get bucket of a value
+        @param  nValue - value
+        @retval        - bucket index
+    **/
+    static constexpr size_t get_bucket(u64 nValue) noexcept;
+
+    /**
+        @brief  Get the smallest value of a bucket
+        @param  nBucket - bucket index
+        @retval         - the smallest value of the bucket
+    **/
+    static constexpr u64 get_bucket_lower_bound(size_t nBucket) noexcept;
+
+    /**
+        @brief  Get the biggest value of a bucket
+        @param  nBucket - bucket index
+        @retval         - the biggest value of the bucket
+    **/
+    static constexpr u64 get_bucket_upper_bound(size_t nBucket) noexcept;
+};
+
+/**
+
+    @struct  metric_snapshot
+    @brief   Value of a metric merged from all threads
+    @author  Khrapov
+    @date    17.10.2026
+
+**/
+struct metric_snapshot
+{
+    std::string sCategory; // UTF-8
+    std::string sName;
+    metric_type eType = metric_type::counter;
+
+    // counter
+    u64 nCounter = 0;
+
+    // gauge
+    double fGauge = 0.0;
+
+    // histogram
+    u64              nCount = 0;
+    u64              nSum   = 0;
+    u64              nMax   = 0;
+    std::vector<u64> buckets; // empty if there are no values
+
+    /**
+        @brief  Get approximate histogram percentile
+        @param  fPercentile - percentile in [0, 1]
+        @retval             - upper bound of the bucket with the percentile, not bigger than the max value
+    **/
+    u64 get_percentile(double fPercentile) const noexcept;
+
+    /**
+        @brief  Get histogram mean value
+        @retval  - histogram mean value
+    **/
+    double get_mean() const noexcept;
+};
+
+using metrics_snapshot = std::vector<metric_snapshot>;
+
+namespace details
+{
+
+/**
+    @struct metric_info
+    @brief  Registered metric
+**/
+struct metric_info
+{
+    static constexpr u32 k_nInvalidSlot = static_cast<u32>(-1);
+
+    std::string         sCategory;
+    std::string         sName;
+    metric_type         eType = metric_type::counter;
+    u32                 nSlot = k_nInvalidSlot; // first slot of per-thread values
+    std::atomic<double> fGauge = 0.0;
+};
+
+/**
+
+    @class   metrics_thread_storage
+    @brief   Per-thread metric values
+    @details Only the owner thread writes values, so it doesn't need read-modify-write operations.
+             Chunks of slots are allocated on the first write and never moved or deleted,
+             so other threads may read them without locks
+    @author  Khrapov
+    @date    17.10.2026
+
+**/
+class metrics_thread_storage
+{
+public:
+    static constexpr size_t k_nChunkSize = 4096;
+    static constexpr size_t k_nMaxChunks = 256;
+
+    using chunk = std::array<std::atomic<u64>, k_nChunkSize>;
+
+public:
+    QX_NONCOPYMOVABLE(metrics_thread_storage);
+
+    metrics_thread_storage() noexcept = default;
+    ~metrics_thread_storage()         = default;
+
+    /**
+        @brief  Get slot for writing, owner side
+        @param  nSlot - slot index
+        @retval       - slot or nullptr if its chunk can't be allocated
+    **/
+    std::atomic<u64>* get_slot(u32 nSlot) noexcept;
+
+    /**
+        @brief  Get slot for reading
+        @param  nSlot - slot index
+        @retval       - slot or nullptr if nothing has been written to its chunk yet
+    **/
+    const std::atomic<u64>* find_slot(u32 nSlot) const noexcept;
+
+public:
+    std::atomic<bool>       bInUse = true; // false when the thread is finished
+    metrics_thread_storage* pNext  = nullptr;
+
+private:
+    std::array<std::atomic<chunk*>, k_nMaxChunks> m_Chunks {};
+};
+
+} // namespace details
+
+/**
+
+    @class   metrics
+    @brief   Process wide registry of metrics identified by category and name
+    @details Counters and histograms are written to per-thread storage without locks and atomic read-modify-write
+             operations and are merged when a snapshot is collected. Gauges are shared atomics.
+             Metrics with the same category name and metric name are the same metric
+    @author  Khrapov
+    @date    17.10.2026
+
+**/
+class metrics
+{
+public:
+    /**
+        @brief  Register a metric or find a registered one
+        @param  category - metric category
+        @param  svName   - metric name
+        @param  eType    - metric type
+        @retval          - metric info, never deleted, nullptr if the name is registered with another type
+    **/
+    static details::metric_info* register_metric(const category& category, std::string_view svName, metric_type eType);
+
+    /**
+        @brief  Get per-thread storage of the current thread, create it if there is none
+        @retval  - storage of the current thread or nullptr if it can't be allocated
+    **/
+    static details::metrics_thread_storage* get_thread_storage() noexcept;
+
+    /**
+        @brief  Merge values of all threads
+        @retval  - values of all registered metrics in the registration order
+    **/
+    static metrics_snapshot collect();
+
+private:
+    struct registry
+    {
+        std::mutex                                        mutex;
+        std::vector<std::unique_ptr<details::metric_info>> metrics;
+        u32                                               nSlots = 0;
+    };
+
+    /**
+        @brief  Get metrics registry
+        @retval  - metrics registry
+    **/
+    static registry& get_registry() noexcept;
+
+    /**
+        @brief  Get list head of storages of all threads
+        @retval  - storages list head, storages are never deleted and are reused by new threads
+    **/
+    static std::atomic<details::metrics_thread_storage*>& get_thread_storages() noexcept;
+};
+
+/**
+
+    @class   metric_counter
+    @brief   Monotonic counter
+    @author  Khrapov
+    @date    17.10.2026
+
+**/
+class metric_counter
+{
+public:
+    /**
+        @brief metric_counter object constructor
+        @param category - metric category
+        @param svName   - metric name
+    **/
+    metric_counter(const category& category, std::string_view svName);
+
+    /**
+        @brief Increase the counter
+        @param nValue - value to add
+    **/
+    void add(u64 nValue = 1) const noexcept;
+
+private:
+    u32 m_nSlot = details::metric_info::k_nInvalidSlot;
+};
+
+/**
+
+    @class   metric_gauge
+    @brief   Current value of something, e.g. a queue size
+    @author  Khrapov
+    @date    17.10.2026
+
+**/
+class metric_gauge
+{
+public:
+    /**
+        @brief metric_gauge object constructor
+        @param category - metric category
+        @param svName   - metric name
+    **/
+    metric_gauge(const category& category, std::string_view svName);
+
+    /**
+        @brief Set the gauge value
+        @param fValue - new value
+    **/
+    void set(double fValue) const noexcept;
+
+    /**
+        @brief Add to the gauge value
+        @param fValue - value to add, may be negative
+    **/
+    void add(double fValue) const noexcept;
+
+private:
+    details::metric_info* m_pInfo = nullptr;
+};
+
+/**
+
+    @class   metric_histogram
+    @brief   Distribution of values, e.g. latencies in nanoseconds
+    @details See metric_histogram_layout for the buckets layout
+    @author  Khrapov
+    @date    17.10.2026
+
+**/
+class metric_histogram
+{
+public:
+    /**
+        @brief metric_histogram object constructor
+        @param category - metric category
+        @param svName   - metric name
+    **/
+    metric_histogram(const category& category, std::string_view svName);
+
+    /**
+        @brief Record a value
+        @param nValue - value
+    **/
+    void record(u64 nValue) const noexcept;
+
+    /**
+        @brief  Record a duration in nanoseconds
+        @tparam rep_t    - duration arithmetic type
+        @tparam period_t - duration period type
+        @param  duration - duration
+    **/
+    template<class rep_t, class period_t>
+    void record(std::chrono::duration<rep_t, period_t> duration) const noexcept;
+
+private:
+    u32 m_nSlot = details::metric_info::k_nInvalidSlot;
+};
+
+/**
+    @brief Write metrics snapshot as text, one metric per line
+    @param stream   - output stream
+    @param snapshot - metrics snapshot
+**/
+void export_metrics_text(std::ostream& stream, const metrics_snapshot& snapshot);
+
+/**
+    @brief Write metrics snapshot as JSON
+    @param stream   - output stream
+    @param snapshot - metrics snapshot
+**/
+void export_metrics_json(std::ostream& stream, const metrics_snapshot& snapshot);
+
+} // namespace qx
+
+#include <qx/stat/metrics.inl>
@@ -0,0 +1,460 @@
+/**
+
+    @file      metrics.inl
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+
+namespace qx
+{
+
+namespace details
+{
+
+// histogram slots: buckets, then sum and max
+constexpr size_t k_nMetricHistogramSumSlot   = metric_histogram_layout::k_nBuckets;
+constexpr size_t k_nMetricHistogramMaxSlot   = metric_histogram_layout::k_nBuckets + 1;
+constexpr size_t k_nMetricHistogramSlotsSize = metric_histogram_layout::k_nBuckets + 2;
+
+static_assert(k_nMetricHistogramSlotsSize <= metrics_thread_storage::k_nChunkSize);
+
+inline void add_to_slot(std::atomic<u64>& nSlot, u64 nValue) noexcept
+{
+    // only the owner thread writes the slot
+    nSlot.store(nSlot.load(std::memory_order_relaxed) + nValue, std::memory_order_relaxed);
+}
+
+inline std::atomic<u64>* metrics_thread_storage::get_slot(u32 nSlot) noexcept
+{
+    std::atomic<chunk*>& pChunk   = m_Chunks[nSlot / k_nChunkSize];
+    chunk*               pCurrent = pChunk.load(std::memory_order_relaxed);
+
+    if (!pCurrent)
+    {
+        pCurrent = new (std::nothrow) chunk {};
+        if (!pCurrent)
+            return nullptr;
+
+        pChunk.store(pCurrent, std::memory_order_release);
+    }
+
+    return &(*pCurrent)[nSlot % k_nChunkSize];
+}
+
+inline const std::atomic<u64>* metrics_thread_storage::find_slot(u32 nSlot) const noexcept
+{
+    const chunk* pChunk = m_Chunks[nSlot / k_nChunkSize].load(std::memory_order_acquire);
+    return pChunk ? &(*pChunk)[nSlot % k_nChunkSize] : nullptr;
+}
+
+} // namespace details
+
+constexpr size_t metric_histogram_layout::get_bucket(u64 nValue) noexcept
+{
+    const size_t nBits = static_cast<size_t>(std::bit_width(nValue));
+    if (nBits <= k_nSubBucketBits + 1)
+        return static_cast<size_t>(nValue);
+
+    const size_t nShift = nBits - k_nSubBucketBits - 1;
+    return (nShift + 1) * k_nSubBuckets + static_cast<size_t>(nValue >> nShift) - k_nSubBuckets;
+}
+
+constexpr u64 metric_histogram_layout::get_bucket_lower_bound(size_t nBucket) noexcept
+{
+    if (nBucket < 2 * k_nSubBuckets)
+        return nBucket;
+
+    const size_t nShift = nBucket / k_nSubBuckets - 1;
+    return static_cast<u64>(k_nSubBuckets + nBucket % k_nSubBuckets) << nShift;
+}
+
+constexpr u64 metric_histogram_layout::get_bucket_upper_bound(size_t nBucket) noexcept
+{
+    if (nBucket < 2 * k_nSubBuckets)
+        return nBucket;
+
+    const size_t nShift = nBucket / k_nSubBuckets - 1;
+    return get_bucket_lower_bound(nBucket) + ((u64(1) << nShift) - 1);
+}
+
+inline u64 metric_snapshot::get_percentile(double fPercentile) const noexcept
+{
+    if (nCount == 0)
+        return 0;
+
+    const u64 nRank = std::max<u64>(static_cast<u64>(fPercentile * static_cast<double>(nCount) + 0.5), 1);
+
+    u64 nCumulative = 0;
+    for (size_t i = 0; i < buckets.size(); ++i)
+    {
+        nCumulative += buckets[i];
+        if (nCumulative >= nRank)
+            return std::min(metric_histogram_layout::get_bucket_upper_bound(i), nMax);
+    }
+
+    return nMax;
+}
+
+inline double metric_snapshot::get_mean() const noexcept
+{
+    return nCount > 0 ? static_cast<double>(nSum) / static_cast<double>(nCount) : 0.0;
+}
+
+inline details::metric_info* metrics::register_metric(
+    const category&  category,
+    std::string_view svName,
+    metric_type      eType)
+{
+    const string_view svCategory = category.get_name();
+
+    std::string sCategory(get_max_utf8_size<char_type>(svCategory.size()), '\0');
+    sCategory.resize(encode_utf8(svCategory, sCategory.data()));
+
+    registry& metricsRegistry = get_registry();
+
+    std::lock_guard lock(metricsRegistry.mutex);
+
+    for (const auto& pInfo : metricsRegistry.metrics)
+    {
+        if (pInfo->sCategory == sCategory && pInfo->sName == svName)
+            return pInfo->eType == eType ? pInfo.get() : nullptr;
+    }
+
+    auto pInfo       = std::make_unique<details::metric_info>();
+    pInfo->sCategory = std::move(sCategory);
+    pInfo->sName     = svName;
+    pInfo->eType     = eType;
+
+    size_t nSlotsSize = 0;
+    switch (eType)
+    {
+    case metric_type::counter:
+        nSlotsSize = 1;
+        break;
+
+    case metric_type::histogram:
+        nSlotsSize = details::k_nMetricHistogramSlotsSize;
+        break;
+
+    case metric_type::gauge:
+        break;
+    }
+
+    if (nSlotsSize > 0)
+    {
+        constexpr size_t k_nChunkSize = details::metrics_thread_storage::k_nChunkSize;
+        constexpr size_t k_nMaxSlots  = k_nChunkSize * details::metrics_thread_storage::k_nMaxChunks;
+
+        // slots of a metric never cross a chunk border
+        size_t nSlot = metricsRegistry.nSlots;
+        if (nSlot / k_nChunkSize != (nSlot + nSlotsSize - 1) / k_nChunkSize)
+            nSlot = (nSlot / k_nChunkSize + 1) * k_nChunkSize;
+
+        // metrics which don't fit are registered but never written
+        if (nSlot + nSlotsSize <= k_nMaxSlots)
+        {
+            pInfo->nSlot           = static_cast<u32>(nSlot);
+            metricsRegistry.nSlots = static_cast<u32>(nSlot + nSlotsSize);
+        }
+    }
+
+    return metricsRegistry.metrics.emplace_back(std::move(pInfo)).get();
+}
+
+inline details::metrics_thread_storage* metrics::get_thread_storage() noexcept
+{
+    struct thread_storage
+    {
+        thread_storage() noexcept
+        {
+            auto& pStorages = get_thread_storages();
+
+            // values of a finished thread are still counted, so its storage may be continued by a new one
+            for (details::metrics_thread_storage* pFree = pStorages.load(std::memory_order_acquire); pFree;
+                 pFree = pFree->pNext)
+            {
+                bool bInUse = false;
+                if (pFree->bInUse.compare_exchange_strong(bInUse, true, std::memory_order_acquire))
+                {
+                    pStorage = pFree;
+                    return;
+                }
+            }
+
+            // storages are never deleted, so the collector may walk the list without locks
+            pStorage = new (std::nothrow) details::metrics_thread_storage;
+            if (!pStorage)
+                return;
+
+            pStorage->pNext = pStorages.load(std::memory_order_relaxed);
+            while (!pStorages.compare_exchange_weak(pStorage->pNext, pStorage, std::memory_order_release))
+            {
+            }
+        }
+
+        ~thread_storage()
+        {
+            if (pStorage)
+                pStorage->bInUse.store(false, std::memory_order_release);
+        }
+
+        details::metrics_thread_storage* pStorage = nullptr;
+    };
+
+    thread_local thread_storage storage;
+    return storage.pStorage;
+}
+
+inline metrics_snapshot metrics::collect()
+{
+    metrics_snapshot snapshot;
+
+    registry& metricsRegistry = get_registry();
+
+    std::lock_guard lock(metricsRegistry.mutex);
+
+    snapshot.reserve(metricsRegistry.metrics.size());
+
+    for (const auto& pInfo : metricsRegistry.metrics)
+    {
+        metric_snapshot& metric = snapshot.emplace_back();
+        metric.sCategory        = pInfo->sCategory;
+        metric.sName            = pInfo->sName;
+        metric.eType            = pInfo->eType;
+
+        if (pInfo->eType == metric_type::gauge)
+        {
+            metric.fGauge = pInfo->fGauge.load(std::memory_order_relaxed);
+            continue;
+        }
+
+        if (pInfo->nSlot == details::metric_info::k_nInvalidSlot)
+            continue;
+
+        for (const details::metrics_thread_storage* pStorage = get_thread_storages().load(std::memory_order_acquire);
+             pStorage;
+             pStorage = pStorage->pNext)
+        {
+            const std::atomic<u64>* pSlots = pStorage->find_slot(pInfo->nSlot);
+            if (!pSlots)
+                continue;
+
+            if (pInfo->eType == metric_type::counter)
+            {
+                metric.nCounter += pSlots->load(std::memory_order_relaxed);
+                continue;
+            }
+
+            if (metric.buckets.empty())
+                metric.buckets.resize(metric_histogram_layout::k_nBuckets);
+
+            for (size_t i = 0; i < metric_histogram_layout::k_nBuckets; ++i)
+            {
+                const u64 nBucketCount = pSlots[i].load(std::memory_order_relaxed);
+                metric.buckets[i] += nBucketCount;
+                metric.nCount += nBucketCount;
+            }
+
+            metric.nSum += pSlots[details::k_nMetricHistogramSumSlot].load(std::memory_order_relaxed);
+            metric.nMax =
+                std::max(metric.nMax, pSlots[details::k_nMetricHistogramMaxSlot].load(std::memory_order_relaxed));
+        }
+
+        if (metric.nCount == 0)
+            metric.buckets.clear();
+    }
+
+    return snapshot;
+}
+
+inline metrics::registry& metrics::get_registry() noexcept
+{
+    static registry metricsRegistry;
+    return metricsRegistry;
+}
+
+inline std::atomic<details::metrics_thread_storage*>& metrics::get_thread_storages() noexcept
+{
+    static std::atomic<details::metrics_thread_storage*> pStorages = nullptr;
+    return pStorages;
+}
+
+inline metric_counter::metric_counter(const category& category, std::string_view svName)
+{
+    if (const details::metric_info* pInfo = metrics::register_metric(category, svName, metric_type::counter))
+        m_nSlot = pInfo->nSlot;
+}
+
+inline void metric_counter::add(u64 nValue) const noexcept
+{
+    if (m_nSlot == details::metric_info::k_nInvalidSlot)
+        return;
+
+    details::metrics_thread_storage* pStorage = metrics::get_thread_storage();
+    if (!pStorage)
+        return;
+
+    if (std::atomic<u64>* pSlot = pStorage->get_slot(m_nSlot))
+        details::add_to_slot(*pSlot, nValue);
+}
+
+inline metric_gauge::metric_gauge(const category& category, std::string_view svName)
+    : m_pInfo(metrics::register_metric(category, svName, metric_type::gauge))
+{
+}
+
+inline void metric_gauge::set(double fValue) const noexcept
+{
+    if (m_pInfo)
+        m_pInfo->fGauge.store(fValue, std::memory_order_relaxed);
+}
+
+inline void metric_gauge::add(double fValue) const noexcept
+{
+    if (m_pInfo)
+        m_pInfo->fGauge.fetch_add(fValue, std::memory_order_relaxed);
+}
+
+inline metric_histogram::metric_histogram(const category& category, std::string_view svName)
+{
+    if (const details::metric_info* pInfo = metrics::register_metric(category, svName, metric_type::histogram))
+        m_nSlot = pInfo->nSlot;
+}
+
+inline void metric_histogram::record(u64 nValue) const noexcept
+{
+    if (m_nSlot == details::metric_info::k_nInvalidSlot)
+        return;
+
+    details::metrics_thread_storage* pStorage = metrics::get_thread_storage();
+    if (!pStorage)
+        return;
+
+    std::atomic<u64>* pSlots = pStorage->get_slot(m_nSlot);
+    if (!pSlots)
+        return;
+
+    details::add_to_slot(pSlots[metric_histogram_layout::get_bucket(nValue)], 1);
+    details::add_to_slot(pSlots[details::k_nMetricHistogramSumSlot], nValue);
+
+    std::atomic<u64>& nMax = pSlots[details::k_nMetricHistogramMaxSlot];
+    if (nValue > nMax.load(std::memory_order_relaxed))
+        nMax.store(nValue, std::memory_order_relaxed);
+}
+
+template<class rep_t, class period_t>
+inline void metric_histogram::record(std::chrono::duration<rep_t, period_t> duration) const noexcept
+{
+    const auto nNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    record(static_cast<u64>(std::max<decltype(nNanoseconds)>(nNanoseconds, 0)));
+}
+
+inline void export_metrics_text(std::ostream& stream, const metrics_snapshot& snapshot)
+{
+    std::string sText;
+
+    for (const metric_snapshot& metric : snapshot)
+    {
+        switch (metric.eType)
+        {
+        case metric_type::counter:
+            std::format_to(
+                std::back_inserter(sText),
+                "{}/{} counter {}\n",
+                metric.sCategory,
+                metric.sName,
+                metric.nCounter);
+            break;
+
+        case metric_type::gauge:
+            std::format_to(std::back_inserter(sText), "{}/{} gauge {}\n", metric.sCategory, metric.sName, metric.fGauge);
+            break;
+
+        case metric_type::histogram:
+            std::format_to(
+                std::back_inserter(sText),
+                "{}/{} histogram count={} mean={:.1f} p50={} p90={} p99={} max={}\n",
+                metric.sCategory,
+                metric.sName,
+                metric.nCount,
+                metric.get_mean(),
+                metric.get_percentile(0.5),
+                metric.get_percentile(0.9),
+                metric.get_percentile(0.99),
+                metric.nMax);
+            break;
+        }
+    }
+
+    stream.write(sText.data(), static_cast<std::streamsize>(sText.size()));
+}
+
+inline void export_metrics_json(std::ostream& stream, const metrics_snapshot& snapshot)
+{
+    std::string sJson = "{\"metrics\":[";
+
+    for (size_t i = 0; i < snapshot.size(); ++i)
+    {
+        const metric_snapshot& metric = snapshot[i];
+
+        sJson += i > 0 ? ",\n{\"category\":\"" : "\n{\"category\":\"";
+        details::append_json_escaped(sJson, metric.sCategory);
+        sJson += "\",\"name\":\"";
+        details::append_json_escaped(sJson, metric.sName);
+        sJson += '"';
+
+        switch (metric.eType)
+        {
+        case metric_type::counter:
+            std::format_to(std::back_inserter(sJson), ",\"type\":\"counter\",\"value\":{}", metric.nCounter);
+            break;
+
+        case metric_type::gauge:
+            std::format_to(std::back_inserter(sJson), ",\"type\":\"gauge\",\"value\":{}", metric.fGauge);
+            break;
+
+        case metric_type::histogram:
+            std::format_to(
+                std::back_inserter(sJson),
+                ",\"type\":\"histogram\",\"count\":{},\"sum\":{},\"max\":{},\"p50\":{},\"p90\":{},\"p99\":{},"
+                "\"buckets\":[",
+                metric.nCount,
+                metric.nSum,
+                metric.nMax,
+                metric.get_percentile(0.5),
+                metric.get_percentile(0.9),
+                metric.get_percentile(0.99));
+
+            // only non-empty buckets as [lower bound, upper bound, count]
+            bool bFirstBucket = true;
+            for (size_t nBucket = 0; nBucket < metric.buckets.size(); ++nBucket)
+            {
+                if (metric.buckets[nBucket] == 0)
+                    continue;
+
+                std::format_to(
+                    std::back_inserter(sJson),
+                    "{}[{},{},{}]",
+                    bFirstBucket ? "" : ",",
+                    metric_histogram_layout::get_bucket_lower_bound(nBucket),
+                    metric_histogram_layout::get_bucket_upper_bound(nBucket),
+                    metric.buckets[nBucket]);
+
+                bFirstBucket = false;
+            }
+
+            sJson += ']';
+            break;
+        }
+
+        sJson += '}';
+    }
+
+    sJson += "\n]}\n";
+
+    stream.write(sJson.data(), static_cast<std::streamsize>(sJson.size()));
+}
+
+} // namespace qx
@@ -0,0 +1,127 @@
+/**
+
+    @file      test_allocation_tracker.cpp
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+#include <common.h>
+
+//V_EXCLUDE_PATH *test_allocation_tracker.cpp
+
+#define QX_CONF_USE_PROFILER
+#define QX_CONF_USE_ALLOCATION_TRACKER
+
+#include <qx/category.h>
+#include <qx/containers/string/string.h>
+#include <qx/internal/perf_scope.h>
+#include <qx/profiler/allocation_tracker.h>
+#include <qx/profiler/folded_stacks.h>
+
+#include <memory>
+#include <sstream>
+#include <thread>
+
+QX_DEFINE_ALLOCATION_TRACKER_NEW_DELETE();
+
+QX_DEFINE_CATEGORY(CatAllocationTrackerTest, qx::color::white());
+
+namespace
+{
+
+constexpr size_t k_nArraySize = 10;
+
+struct alignas(64) overaligned_object
+{
+    char data[64];
+};
+
+void allocating_function()
+{
+    QX_PERF_SCOPE();
+
+    std::unique_ptr<int[]> pArray(new int[k_nArraySize]);
+
+    {
+        QX_PERF_SCOPE(CatAllocationTrackerTest, "Overaligned");
+        auto pObject = std::make_unique<overaligned_object>();
+    }
+}
+
+void string_function()
+{
+    QX_PERF_SCOPE();
+
+    qx::string sString;
+    sString.assign(1000, QX_TEXT('a'));
+}
+
+} // namespace
+
+TEST(allocation_tracker, call_tree)
+{
+    // reset counters of previous tests
+    qx::profiler::collect_call_tree(true);
+    qx::profiler::start_call_tree();
+
+    std::thread thread(
+        []()
+        {
+            allocating_function();
+            allocating_function();
+            string_function();
+        });
+    thread.join();
+
+    qx::profiler::stop_call_tree();
+
+    const qx::profiler_call_tree_node callTree = qx::profiler::collect_call_tree();
+
+    const qx::profiler_call_tree_node& function = *callTree.children.at("allocating_function");
+    EXPECT_EQ(function.nAllocations, 2);
+    EXPECT_EQ(function.nDeallocations, 2);
+    EXPECT_EQ(function.nAllocatedBytes, 2 * k_nArraySize * sizeof(int));
+
+    const qx::profiler_call_tree_node& overaligned = *function.children.at("Overaligned");
+    EXPECT_EQ(overaligned.nAllocations, 2);
+    EXPECT_EQ(overaligned.nDeallocations, 2);
+    EXPECT_EQ(overaligned.nAllocatedBytes, 2 * sizeof(overaligned_object));
+
+    const qx::profiler_call_tree_node& stringFunction = *callTree.children.at("string_function");
+    EXPECT_GE(stringFunction.nAllocations, 1);
+    EXPECT_EQ(stringFunction.nDeallocations, 1);
+    EXPECT_GE(stringFunction.nAllocatedBytes, 1000 * sizeof(qx::char_type));
+
+    std::ostringstream stream;
+    qx::export_folded_stacks(stream, callTree, qx::folded_stacks_value::allocated_bytes);
+
+    const std::string sStacks = stream.str();
+    EXPECT_NE(
+        sStacks.find("allocating_function " + std::to_string(2 * k_nArraySize * sizeof(int))),
+        std::string::npos);
+    EXPECT_NE(
+        sStacks.find("allocating_function;Overaligned " + std::to_string(2 * sizeof(overaligned_object))),
+        std::string::npos);
+}
+
+TEST(allocation_tracker, disabled_call_tree)
+{
+    qx::profiler::collect_call_tree(true);
+
+    std::thread thread(
+        []()
+        {
+            allocating_function();
+        });
+    thread.join();
+
+    const qx::profiler_call_tree_node callTree = qx::profiler::collect_call_tree();
+
+    const auto itFunction = callTree.children.find("allocating_function");
+    if (itFunction != callTree.children.end())
+    {
+        EXPECT_EQ(itFunction->second->nCalls, 0);
+        EXPECT_EQ(itFunction->second->nAllocations, 0);
+    }
+}
@@ -0,0 +1,188 @@
+/**
+
+    @file      test_assert_failure_counter.cpp
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+#include <common.h>
+
+//V_EXCLUDE_PATH *test_assert_failure_counter.cpp
+
+namespace
+{
+
+// every call site reads the period on its first failure, so the tests choose it instead of relying on timings
+std::chrono::steady_clock::duration g_ReportPeriod = std::chrono::hours(1);
+
+} // namespace
+
+#define QX_CONF_ASSERT_FAILURE_COUNTER
+#define QX_CONF_ASSERT_FAILURE_REPORT_PERIOD g_ReportPeriod
+#define QX_EXPECT_DEBUG_BREAK                QX_EMPTY_MACRO
+
+#include <qx/macros/assert.h>
+
+#include <thread>
+
+namespace
+{
+
+class counting_logger_stream : public qx::base_logger_stream
+{
+public:
+    counting_logger_stream() : base_logger_stream(false)
+    {
+    }
+
+    virtual void flush() override
+    {
+        ++m_nFlushes;
+    }
+
+    const std::vector<qx::string>& get_messages() const
+    {
+        return m_Messages;
+    }
+
+    size_t get_flushes() const
+    {
+        return m_nFlushes;
+    }
+
+private:
+    virtual void do_log(
+        qx::string_view                            svMessage,
+        const qx::log_unit&                        logUnit,
+        const std::vector<qx::logger_color_range>& colors,
+        qx::verbosity                              eVerbosity) override
+    {
+        m_Messages.emplace_back(svMessage);
+    }
+
+private:
+    std::vector<qx::string> m_Messages;
+    size_t                  m_nFlushes = 0;
+};
+
+bool fail_in_named_function(int nValue)
+{
+    return QX_EXPECT(nValue < 0);
+}
+
+u64 read_number_after(qx::string_view svMessage, qx::string_view svPrefix)
+{
+    size_t nPos = svMessage.find(svPrefix);
+    if (nPos == qx::string_view::npos)
+        return 0;
+
+    u64 nNumber = 0;
+    for (nPos += svPrefix.size();
+         nPos < svMessage.size() && svMessage[nPos] >= QX_TEXT('0') && svMessage[nPos] <= QX_TEXT('9');
+         ++nPos)
+        nNumber = nNumber * 10 + static_cast<u64>(svMessage[nPos] - QX_TEXT('0'));
+
+    return nNumber;
+}
+
+} // namespace
+
+TEST(assert_failure_counter, report)
+{
+    qx::details::assert_failure_counter counter(std::chrono::hours(1));
+
+    u64 nNewFailures = 0;
+    u64 nFailures    = 0;
+    EXPECT_EQ(counter.on_failure(nNewFailures, nFailures), qx::details::assert_failure_counter::report::full);
+
+    for (int i = 0; i < 100; ++i)
+        EXPECT_EQ(counter.on_failure(nNewFailures, nFailures), qx::details::assert_failure_counter::report::none);
+}
+
+TEST(assert_failure_counter, expect_in_loop)
+{
+    constexpr int k_nIterations = 1000;
+
+    g_ReportPeriod = std::chrono::hours(1);
+
+    auto  pStream    = std::make_unique<counting_logger_stream>();
+    auto* pRawStream = pStream.get();
+    QX_LOGGER_INSTANCE.add_stream(std::move(pStream));
+
+    auto fail = [](int nValue)
+    {
+        return QX_EXPECT(nValue < 0, QX_TEXT("value {}"), nValue);
+    };
+
+    for (int i = 0; i < k_nIterations; ++i)
+        EXPECT_FALSE(fail(i));
+
+    // only the first failure is reported in full and flushed
+    ASSERT_EQ(pRawStream->get_messages().size(), 1);
+    EXPECT_NE(pRawStream->get_messages()[0].find(QX_TEXT("value 0")), qx::string::npos);
+    EXPECT_EQ(pRawStream->get_flushes(), 1);
+
+    QX_LOGGER_INSTANCE.reset();
+}
+
+TEST(assert_failure_counter, aggregated_report)
+{
+    constexpr int k_nIterations = 1000;
+
+    // the loop may span any number of periods, only the sum of the reported counts is fixed
+    g_ReportPeriod = std::chrono::milliseconds(1);
+
+    auto  pStream    = std::make_unique<counting_logger_stream>();
+    auto* pRawStream = pStream.get();
+    QX_LOGGER_INSTANCE.add_stream(std::move(pStream));
+
+    auto fail = [](int nValue)
+    {
+        return QX_EXPECT(nValue < 0, QX_TEXT("value {}"), nValue);
+    };
+
+    for (int i = 0; i < k_nIterations; ++i)
+        EXPECT_FALSE(fail(i));
+
+    // sleeping at least a period guarantees the next failure is reported
+    std::this_thread::sleep_for(2 * g_ReportPeriod);
+    EXPECT_FALSE(fail(k_nIterations));
+
+    const std::vector<qx::string>& messages = pRawStream->get_messages();
+    ASSERT_GE(messages.size(), 2);
+    EXPECT_NE(messages.front().find(QX_TEXT("value 0")), qx::string::npos);
+
+    u64 nReported = 0;
+    for (size_t i = 1; i < messages.size(); ++i)
+        nReported += read_number_after(messages[i], QX_TEXT("failed "));
+
+    EXPECT_EQ(nReported, k_nIterations);
+    EXPECT_EQ(read_number_after(messages.back(), QX_TEXT("more times, ")), k_nIterations + 1);
+    EXPECT_EQ(pRawStream->get_flushes(), 1);
+
+    QX_LOGGER_INSTANCE.reset();
+}
+
+TEST(assert_failure_counter, function_name)
+{
+    // every failure after the first one is reported as aggregated
+    g_ReportPeriod = std::chrono::steady_clock::duration::zero();
+
+    auto  pStream    = std::make_unique<counting_logger_stream>();
+    auto* pRawStream = pStream.get();
+    QX_LOGGER_INSTANCE.add_stream(std::move(pStream));
+
+    EXPECT_FALSE(fail_in_named_function(0));
+    EXPECT_FALSE(fail_in_named_function(1));
+
+    // both the full and the aggregated reports name the function, not the call operator of a lambda
+    ASSERT_EQ(pRawStream->get_messages().size(), 2);
+    for (const qx::string& sMessage : pRawStream->get_messages())
+    {
+        EXPECT_NE(sMessage.find(QX_TEXT("fail_in_named_function")), qx::string::npos);
+        EXPECT_EQ(sMessage.find(QX_TEXT("operator")), qx::string::npos);
+    }
+
+    QX_LOGGER_INSTANCE.reset();
+}
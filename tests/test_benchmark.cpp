@@ -11,7 +11,10 @@
 //V_EXCLUDE_PATH *test_benchmark.cpp
 
 #include <cmath>
+#include <numeric>
+#include <sstream>
 #include <thread>
+#include <vector>
 
 #include <qx/stat/benchmark.h>
 
@@ -30,3 +33,77 @@ TEST(benchmark, benchmark)
         EXPECT_GE(duration, WAIT_INTERVAL);
     }
 }
+
+TEST(benchmark, run)
+{
+    qx::benchmark_options options;
+    options.warmupTime               = std::chrono::milliseconds(1);
+    options.sampleTime               = std::chrono::milliseconds(1);
+    options.nSamples                 = 10;
+    options.bMeasureCycles           = true;
+    options.bMeasureHardwareCounters = true;
+
+    std::vector<int> values(1000);
+    std::iota(values.begin(), values.end(), 0);
+
+    const qx::benchmark_result result = qx::benchmark::run(
+        "accumulate",
+        [&values]
+        {
+            qx::benchmark::do_not_optimize(std::accumulate(values.begin(), values.end(), 0));
+        },
+        options);
+
+    EXPECT_EQ(result.sName, "accumulate");
+    EXPECT_EQ(result.samples.size(), options.nSamples);
+    EXPECT_GT(result.nIterationsPerSample, 1);
+    EXPECT_GT(result.fMin, 0.0);
+    EXPECT_LE(result.fMin, result.fMedian);
+    EXPECT_LE(result.fMedian, result.fP90);
+    EXPECT_LE(result.fP90, result.fP99);
+    EXPECT_GE(result.fStdDev, 0.0);
+
+    std::ostringstream stream;
+    qx::export_benchmark_json(stream, std::span(&result, 1));
+
+    const std::string sJson = stream.str();
+    EXPECT_NE(sJson.find("\"name\":\"accumulate\""), std::string::npos);
+    EXPECT_NE(sJson.find("\"median\":"), std::string::npos);
+    EXPECT_EQ(sJson.back(), '\n');
+}
+
+TEST(benchmark, fixed_iterations)
+{
+    qx::benchmark_options options;
+    options.nWarmupIterations    = 3;
+    options.nIterationsPerSample = 5;
+    options.nSamples             = 4;
+
+    size_t nCalls = 0;
+    qx::benchmark::run(
+        "calls",
+        [&nCalls]
+        {
+            ++nCalls;
+        },
+        options);
+
+    EXPECT_EQ(nCalls, 3 + 5 * 4);
+}
+
+TEST(benchmark, outliers_rejection)
+{
+    qx::benchmark_result result;
+    result.samples = { 10.0, 11.0, 9.0, 10.0, 10.5, 9.5, 10.0, 1000.0 };
+
+    qx::benchmark::calculate_statistics(result, 3.5);
+    EXPECT_EQ(result.nOutliers, 1);
+    EXPECT_DOUBLE_EQ(result.fMin, 9.0);
+    EXPECT_DOUBLE_EQ(result.fMedian, 10.0);
+    EXPECT_DOUBLE_EQ(result.fMean, 10.0);
+    EXPECT_LE(result.fP99, 11.0);
+
+    qx::benchmark::calculate_statistics(result, 0.0);
+    EXPECT_EQ(result.nOutliers, 0);
+    EXPECT_GT(result.fMean, 100.0);
+}
@@ -11,13 +11,31 @@
 
 //V_EXCLUDE_PATH *test_logger.cpp
 
+#include <atomic>
+#include <string_view>
+
+// perf scopes are overridden to count rendered log lines
+std::atomic<int> nLogLineFormats = 0;
+
+inline void count_log_line_format(std::string_view svScope)
+{
+    if (svScope.ends_with("\"Log formatting\""))
+        nLogLineFormats.fetch_add(1, std::memory_order_relaxed);
+}
+
+#define QX_PERF_SCOPE(...) count_log_line_format(#__VA_ARGS__)
+
 #include <qx/logger/logger.h>
 
 #include <qx/logger/cout_logger_stream.h>
 #include <qx/logger/file_logger_stream.h>
+#include <qx/logger/flight_recorder_logger_stream.h>
 
 #include <filesystem>
+#include <fstream>
 #include <regex>
+#include <sstream>
+#include <thread>
 
 static_assert(qx::log_acceptable_args<int>);
 static_assert(qx::log_acceptable_args<float>);
@@ -307,8 +325,7 @@ protected:
 TYPED_TEST_SUITE(TestLogger, Implementations);
 
 #define TEST_LOG(traceFile, format, ...) \
-    myLogger                             \
-        .log(qx::verbosity::log, format, CatDefault, traceFile, qx::to_string(__FUNCTION__), __LINE__, ##__VA_ARGS__)
+    myLogger.log(qx::verbosity::log, format, CatDefault, traceFile, QX_FUNCTION_NAME, __LINE__, ##__VA_ARGS__)
 
 #define TEST_LOG_WARNING(traceFile, format, ...) \
     myLogger.log(                                \
@@ -316,7 +333,7 @@ TYPED_TEST_SUITE(TestLogger, Implementations);
         format,                                  \
         CatDefault,                              \
         traceFile,                               \
-        qx::to_string(__FUNCTION__),             \
+        QX_FUNCTION_NAME,                        \
         __LINE__,                                \
         ##__VA_ARGS__)
 
@@ -326,7 +343,7 @@ TYPED_TEST_SUITE(TestLogger, Implementations);
         format,                                              \
         qx::category { _category },                          \
         traceFile,                                           \
-        qx::to_string(__FUNCTION__),                         \
+        QX_FUNCTION_NAME,                                    \
         __LINE__,                                            \
         ##__VA_ARGS__)
 
@@ -336,7 +353,7 @@ TYPED_TEST_SUITE(TestLogger, Implementations);
         format,                                \
         CatDefault,                            \
         traceFile,                             \
-        qx::to_string(__FUNCTION__),           \
+        QX_FUNCTION_NAME,                      \
         __LINE__,                              \
         ##__VA_ARGS__)
 
@@ -346,7 +363,7 @@ TYPED_TEST_SUITE(TestLogger, Implementations);
         QX_TEXT("[{}] ") format,                      \
         CatDefault,                                   \
         traceFile,                                    \
-        qx::to_string(__FUNCTION__),                  \
+        QX_FUNCTION_NAME,                             \
         __LINE__,                                     \
         QX_TEXT(#expr),                               \
         ##__VA_ARGS__)
@@ -422,4 +439,905 @@ TYPED_TEST(TestLogger, logger_lambda)
     TestLoggerLambda(*TestFixture::m_pLogger);
 }
 
+// counts its formatting to check that rejected messages are not formatted
+struct format_counter
+{
+    int* pnFormats = nullptr;
+};
+
+template<>
+struct std::formatter<format_counter, qx::char_type> : qx::basic_formatter
+{
+    template<class FormatContextType>
+    constexpr auto format(const format_counter& counter, FormatContextType& ctx) const
+    {
+        return std::format_to(ctx.out(), QX_TEXT("{}"), ++*counter.pnFormats);
+    }
+};
+
+class test_logger_stream : public qx::base_logger_stream
+{
+public:
+    test_logger_stream(std::atomic<bool>* pGate = nullptr, bool bStoreMessages = true)
+        : base_logger_stream(false)
+        , m_pGate(pGate)
+        , m_bStoreMessages(bStoreMessages)
+    {
+    }
+
+    virtual void flush() override
+    {
+        ++m_nFlushes;
+    }
+
+    const std::vector<qx::string>& get_messages() const
+    {
+        return m_Messages;
+    }
+
+    size_t get_flushes() const
+    {
+        return m_nFlushes;
+    }
+
+private:
+    virtual void do_log(
+        qx::string_view                            svMessage,
+        const qx::log_unit&                        logUnit,
+        const std::vector<qx::logger_color_range>& colors,
+        qx::verbosity                              eVerbosity) override
+    {
+        if (m_pGate)
+            m_pGate->wait(false);
+
+        if (m_bStoreMessages)
+            m_Messages.emplace_back(svMessage);
+    }
+
+private:
+    std::atomic<bool>*      m_pGate = nullptr;
+    bool                    m_bStoreMessages = true;
+    std::vector<qx::string> m_Messages;
+    size_t                  m_nFlushes = 0;
+};
+
+TEST(logger, time_string)
+{
+    auto check_time_string = [](qx::log_time_precision ePrecision, const qx::char_type* pszRegex)
+    {
+        qx::string sTime;
+        qx::base_logger_stream::append_time_string(sTime, QX_TEXT('.'), QX_TEXT(':'), ePrecision);
+
+        const std::basic_regex<qx::char_type> regex(pszRegex);
+        EXPECT_TRUE(std::regex_match(sTime.data(), regex)) << qx::to_cstring(sTime).c_str();
+
+        return sTime;
+    };
+
+    // rendered twice to check the cached value too
+    for (int i = 0; i < 2; ++i)
+    {
+        check_time_string(qx::log_time_precision::seconds, QX_TEXT("\\d{2}\\.\\d{2}\\.\\d{4}_\\d{2}:\\d{2}:\\d{2}"));
+        check_time_string(
+            qx::log_time_precision::milliseconds,
+            QX_TEXT("\\d{2}\\.\\d{2}\\.\\d{4}_\\d{2}:\\d{2}:\\d{2}\\.\\d{3}"));
+        check_time_string(
+            qx::log_time_precision::microseconds,
+            QX_TEXT("\\d{2}\\.\\d{2}\\.\\d{4}_\\d{2}:\\d{2}:\\d{2}\\.\\d{6}"));
+    }
+
+    qx::string sTime;
+    qx::base_logger_stream::append_time_string(sTime, QX_TEXT('-'), QX_TEXT('-'));
+    EXPECT_EQ(sTime.size(), 19);
+    EXPECT_EQ(sTime[2], QX_TEXT('-'));
+    EXPECT_EQ(sTime[13], QX_TEXT('-'));
+
+    // months are counted from 1
+    const std::time_t t      = std::time(nullptr);
+    const std::tm*    pNow   = std::localtime(&t);
+    const int         nMonth = (sTime[3] - QX_TEXT('0')) * 10 + (sTime[4] - QX_TEXT('0'));
+    EXPECT_EQ(nMonth, pNow->tm_mon + 1);
+}
+
+TEST(logger, file_stream_utf8)
+{
+    const std::filesystem::path path(QX_TEXT("file_stream_utf8.log"));
+    std::filesystem::remove(path);
+
+    auto ReadFile = [&path]()
+    {
+        std::ifstream     ifs(path, std::ios_base::binary);
+        std::stringstream ss;
+        ss << ifs.rdbuf();
+        return ss.str();
+    };
+
+    {
+        // a tiny buffer to check writing when it's full and writing messages longer than the buffer
+        qx::file_logger_stream stream(false, qx::log_file_policy::clear_then_uppend, QX_TEXT("file_stream_utf8"), 64);
+
+        stream.do_log(QX_TEXT("line 1\n"), {}, {}, qx::verbosity::log);
+        stream.do_log(QX_TEXT("\u00e9\u4e2d\U0001F600\n"), {}, {}, qx::verbosity::log);
+        EXPECT_TRUE(ReadFile().empty());
+
+        stream.do_log(
+            QX_TEXT("a line which is longer than the whole buffer, so it's written right away\n"),
+            {},
+            {},
+            qx::verbosity::log);
+        EXPECT_EQ(
+            ReadFile(),
+            "line 1\n\xC3\xA9\xE4\xB8\xAD\xF0\x9F\x98\x80\n"
+            "a line which is longer than the whole buffer, so it's written right away\n");
+
+        stream.do_log(QX_TEXT("line 2\n"), {}, {}, qx::verbosity::log);
+        stream.flush();
+        EXPECT_TRUE(ReadFile().ends_with("away\nline 2\n"));
+    }
+
+    EXPECT_TRUE(ReadFile().ends_with("line 2\n\n\n\n"));
+    std::filesystem::remove(path);
+}
+
+TEST(logger, file_stream_concurrent_flush)
+{
+    constexpr int k_nMessages = 10000;
+
+    const std::filesystem::path path(QX_TEXT("file_stream_concurrent_flush.log"));
+    std::filesystem::remove(path);
+
+    {
+        qx::logger logger;
+        logger.add_stream(std::make_unique<qx::file_logger_stream>(
+            false,
+            qx::log_file_policy::clear_then_uppend,
+            QX_TEXT("file_stream_concurrent_flush"),
+            256));
+
+        // flushes of another thread must not duplicate or lose buffered bytes
+        std::atomic<bool> bStop = false;
+        std::thread       flushThread(
+            [&logger, &bStop]()
+            {
+                while (!bStop)
+                    logger.flush();
+            });
+
+        for (int i = 0; i < k_nMessages; ++i)
+            logger.log(qx::verbosity::log, QX_TEXT("{}"), CatDefault, QX_TEXT("file.cpp"), QX_TEXT("func"), 1, i);
+
+        bStop = true;
+        flushThread.join();
+        logger.flush();
+    }
+
+    std::ifstream ifs(path, std::ios_base::binary);
+    std::string   sLine;
+    int           nLines = 0;
+    while (std::getline(ifs, sLine))
+    {
+        if (sLine.empty())
+            continue;
+
+        if (!sLine.ends_with(" " + std::to_string(nLines)))
+        {
+            ADD_FAILURE() << "unexpected line " << nLines << ": " << sLine;
+            break;
+        }
+
+        ++nLines;
+    }
+
+    EXPECT_EQ(nLines, k_nMessages);
+
+    ifs.close();
+    std::filesystem::remove(path);
+}
+
+TEST(logger, file_stream_rotation)
+{
+    const std::filesystem::path directory(QX_TEXT("file_stream_rotation"));
+    std::filesystem::remove_all(directory);
+
+    auto ReadFile = [&directory](const char* pszFileName)
+    {
+        std::ifstream     ifs(directory / pszFileName, std::ios_base::binary);
+        std::stringstream ss;
+        ss << ifs.rdbuf();
+        return ss.str();
+    };
+
+    {
+        qx::log_file_rotation rotation;
+        rotation.nMaxFileSize = 100;
+        rotation.nMaxFiles    = 2;
+
+        qx::file_logger_stream stream(
+            false,
+            qx::log_file_policy::clear_then_uppend,
+            QX_TEXT("file_stream_rotation/size"),
+            64,
+            qx::log_file_sync_policy::none,
+            rotation);
+
+        for (int i = 0; i < 100; ++i)
+        {
+            stream.do_log(QX_TEXT("0123456789\n"), {}, {}, qx::verbosity::log);
+
+            // give the worker time to prepare the next file
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    EXPECT_TRUE(std::filesystem::exists(directory / "size.log"));
+    EXPECT_FALSE(std::filesystem::exists(directory / "size.3.log"));
+    EXPECT_FALSE(std::filesystem::exists(directory / "size.next.log"));
+    for (const char* pszFileName : { "size.1.log", "size.2.log" })
+    {
+        const std::string sData = ReadFile(pszFileName);
+        EXPECT_GE(sData.size(), 100) << pszFileName;
+        EXPECT_LT(sData.size(), 200) << pszFileName;
+        EXPECT_TRUE(sData.ends_with("0123456789\n")) << pszFileName;
+    }
+
+    {
+        qx::log_file_rotation rotation;
+        rotation.interval  = std::chrono::milliseconds(20);
+        rotation.nMaxFiles = 1;
+
+        qx::file_logger_stream stream(
+            false,
+            qx::log_file_policy::clear_then_uppend,
+            QX_TEXT("file_stream_rotation/interval"),
+            qx::file_logger_stream::k_nDefaultBufferSize,
+            qx::log_file_sync_policy::none,
+            rotation);
+
+        stream.do_log(QX_TEXT("first\n"), {}, {}, qx::verbosity::log);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        stream.do_log(QX_TEXT("second\n"), {}, {}, qx::verbosity::log);
+    }
+
+    EXPECT_EQ(ReadFile("interval.1.log"), "first\n");
+    EXPECT_EQ(ReadFile("interval.log"), "second\n\n\n\n");
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(logger, cout_stream_colors)
+{
+    static_assert(
+        qx::terminal_color::font(qx::color::red()).get_sequence<char>().view() == "\033[38;2;255;0;0m");
+    static_assert(
+        qx::terminal_color::back(qx::color::white()).get_sequence<char>().view() == "\033[48;2;255;255;255m");
+    static_assert(qx::terminal_color::reset().get_sequence<char>().view() == "\033[0m");
+
+    auto GetSequence = [](const qx::terminal_color& terminalColor)
+    {
+        return std::basic_string<qx::char_type>(terminalColor.get_sequence<qx::char_type>().view());
+    };
+
+#ifdef QX_CONF_USE_WCHAR
+    std::basic_ostream<qx::char_type>* pCout = &std::wcout;
+#else
+    std::basic_ostream<qx::char_type>* pCout = &std::cout;
+#endif
+
+    std::basic_ostringstream<qx::char_type> ss;
+    auto*                                   pCoutBuffer = pCout->rdbuf(ss.rdbuf());
+    {
+        qx::cout_logger_stream stream(false, true, false, false);
+        stream.do_log(
+            QX_TEXT("[W] text\n"),
+            {},
+            { { { 1, 2 }, qx::color::red() } },
+            qx::verbosity::warning);
+    }
+    pCout->rdbuf(pCoutBuffer);
+
+    const auto sWarning = GetSequence(qx::terminal_color::font(qx::color::orange()));
+    const auto sRed     = GetSequence(qx::terminal_color::font(qx::color::red()));
+    const auto sReset   = GetSequence(qx::terminal_color::reset());
+    EXPECT_TRUE(
+        ss.str()
+        == sWarning + QX_TEXT("[") + sReset + sRed + QX_TEXT("W") + sReset + sWarning + QX_TEXT("] text\n") + sReset);
+}
+
+TEST(logger, flight_recorder)
+{
+    const std::filesystem::path path(QX_TEXT("flight_recorder_test.log"));
+    std::filesystem::remove(path);
+
+    auto ReadFile = [&path]()
+    {
+        std::ifstream     ifs(path, std::ios_base::binary);
+        std::stringstream ss;
+        ss << ifs.rdbuf();
+        return ss.str();
+    };
+
+    qx::flight_recorder_logger_stream stream(64, qx::verbosity::error, QX_TEXT("flight_recorder_test"));
+    EXPECT_EQ(stream.capacity(), 64);
+
+    qx::string sLine;
+    for (int i = 0; i < 20; ++i)
+    {
+        sLine.format(QX_TEXT("line {}\n"), i);
+        stream.do_log(sLine, {}, {}, qx::verbosity::very_verbose);
+    }
+
+    EXPECT_FALSE(std::filesystem::exists(path));
+    EXPECT_TRUE(stream.dump());
+
+    // only the whole lines of the last 64 chars
+    EXPECT_EQ(ReadFile(), "line 13\nline 14\nline 15\nline 16\nline 17\nline 18\nline 19\n");
+
+    stream.do_log(QX_TEXT("error\n"), {}, {}, qx::verbosity::error);
+    EXPECT_TRUE(ReadFile().ends_with("line 19\nerror\n"));
+
+    // automatic dumps are rate limited
+    stream.do_log(QX_TEXT("error 2\n"), {}, {}, qx::verbosity::error);
+    EXPECT_TRUE(ReadFile().ends_with("line 19\nerror\n"));
+
+    EXPECT_TRUE(stream.dump());
+    EXPECT_TRUE(ReadFile().ends_with("error\nerror 2\n"));
+
+    std::filesystem::remove(path);
+}
+
+TEST(logger, flight_recorder_very_verbose)
+{
+    constexpr qx::category CatVeryVerbose =
+        qx::category(QX_TEXT("CatVeryVerbose")).set_verbosity(qx::verbosity::very_verbose);
+
+    const std::filesystem::path path(QX_TEXT("flight_recorder_very_verbose_test.log"));
+    std::filesystem::remove(path);
+
+    auto pStream = std::make_unique<qx::flight_recorder_logger_stream>(
+        1024,
+        qx::verbosity::error,
+        QX_TEXT("flight_recorder_very_verbose_test"));
+    auto* pRawStream = pStream.get();
+
+    qx::logger logger;
+    logger.add_stream(std::move(pStream));
+    logger.log(
+        qx::verbosity::very_verbose,
+        QX_TEXT("very verbose message"),
+        CatVeryVerbose,
+        QX_TEXT("file.cpp"),
+        QX_TEXT("func"),
+        1);
+
+    EXPECT_TRUE(pRawStream->dump());
+
+    std::ifstream     ifs(path, std::ios_base::binary);
+    std::stringstream ss;
+    ss << ifs.rdbuf();
+    EXPECT_NE(ss.str().find("very verbose message"), std::string::npos);
+
+    ifs.close();
+    std::filesystem::remove(path);
+}
+
+#define TEST_LOG_VALUE(logger, value) \
+    logger.log(qx::verbosity::log, QX_TEXT("msg {}"), CatDefault, QX_TEXT("file.cpp"), QX_TEXT("func"), 1, value)
+
+TEST(logger, async_block)
+{
+    constexpr int k_nThreads    = 4;
+    constexpr int k_nIterations = 1000;
+
+    qx::logger logger;
+
+    auto        pStream = std::make_unique<test_logger_stream>();
+    const auto& stream  = *pStream;
+    logger.add_stream(std::move(pStream));
+
+    logger.enable_async(16, qx::log_queue_overflow_policy::block);
+    EXPECT_TRUE(logger.is_async());
+
+    std::vector<std::thread> threads;
+    for (int nThread = 0; nThread < k_nThreads; ++nThread)
+    {
+        threads.emplace_back(
+            [&logger, nThread]()
+            {
+                for (int i = 0; i < k_nIterations; ++i)
+                    TEST_LOG_VALUE(logger, nThread * k_nIterations + i);
+            });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    logger.flush();
+
+    EXPECT_EQ(stream.get_messages().size(), k_nThreads * k_nIterations);
+    EXPECT_EQ(stream.get_flushes(), 1);
+    EXPECT_EQ(logger.get_dropped_messages_count(), 0);
+
+    for (const auto& sMessage : stream.get_messages())
+        EXPECT_TRUE(sMessage.contains(QX_TEXT("[file.cpp::func::1] msg ")));
+
+    logger.disable_async();
+    EXPECT_FALSE(logger.is_async());
+
+    TEST_LOG_VALUE(logger, 0);
+    EXPECT_EQ(stream.get_messages().size(), k_nThreads * k_nIterations + 1);
+}
+
+TEST(logger, async_drop_newest)
+{
+    constexpr int k_nMessages = 100;
+
+    std::atomic<bool> bGate = false;
+    qx::logger        logger;
+
+    auto        pStream = std::make_unique<test_logger_stream>(&bGate);
+    const auto& stream  = *pStream;
+    logger.add_stream(std::move(pStream));
+
+    logger.enable_async(4, qx::log_queue_overflow_policy::drop_newest);
+
+    for (int i = 0; i < k_nMessages; ++i)
+        TEST_LOG_VALUE(logger, i);
+
+    bGate = true;
+    bGate.notify_all();
+    logger.flush();
+
+    EXPECT_GT(logger.get_dropped_messages_count(), 0);
+    EXPECT_EQ(stream.get_messages().size() + logger.get_dropped_messages_count(), k_nMessages);
+    EXPECT_TRUE(stream.get_messages().front().ends_with(QX_TEXT("msg 0\n")));
+}
+
+TEST(logger, async_drop_oldest)
+{
+    constexpr int k_nMessages = 100;
+
+    std::atomic<bool> bGate = false;
+    qx::logger        logger;
+
+    auto        pStream = std::make_unique<test_logger_stream>(&bGate);
+    const auto& stream  = *pStream;
+    logger.add_stream(std::move(pStream));
+
+    logger.enable_async(4, qx::log_queue_overflow_policy::drop_oldest);
+
+    for (int i = 0; i < k_nMessages; ++i)
+        TEST_LOG_VALUE(logger, i);
+
+    bGate = true;
+    bGate.notify_all();
+    logger.flush();
+
+    EXPECT_GT(logger.get_dropped_messages_count(), 0);
+    EXPECT_EQ(stream.get_messages().size() + logger.get_dropped_messages_count(), k_nMessages);
+    EXPECT_TRUE(stream.get_messages().back().ends_with(QX_TEXT("msg 99\n")));
+}
+
+TEST(logger, async_binary)
+{
+    constexpr int k_nThreads    = 4;
+    constexpr int k_nIterations = 1000;
+
+    auto        pStream = std::make_unique<test_logger_stream>();
+    const auto& stream  = *pStream;
+    QX_LOGGER_INSTANCE.add_stream(std::move(pStream));
+
+    // small buffers to check wrapping and waiting for free space
+    QX_LOGGER_INSTANCE.enable_async(16, qx::log_queue_overflow_policy::block, 256);
+
+    std::vector<std::thread> threads;
+    for (int nThread = 0; nThread < k_nThreads; ++nThread)
+    {
+        threads.emplace_back(
+            [nThread]()
+            {
+                const qx::string sText = QX_TEXT("string");
+                for (int i = 0; i < k_nIterations; ++i)
+                {
+                    QX_LOG_BINARY(
+                        qx::verbosity::log,
+                        QX_TEXT("bin {} {} {:.1f} {} {}"),
+                        nThread,
+                        i,
+                        0.5f,
+                        QX_TEXT("text"),
+                        sText);
+                }
+            });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    QX_LOGGER_INSTANCE.flush();
+
+    EXPECT_EQ(stream.get_messages().size(), k_nThreads * k_nIterations);
+    EXPECT_EQ(QX_LOGGER_INSTANCE.get_dropped_messages_count(), 0);
+
+    // messages of every thread must come in order
+    std::vector<int> nextIterations(k_nThreads, 0);
+    for (const auto& sMessage : stream.get_messages())
+    {
+        const size_t nPos = sMessage.find(QX_TEXT("bin "));
+        ASSERT_NE(nPos, qx::string::npos);
+
+        std::basic_istringstream<qx::char_type> stringStream(sMessage.data() + nPos + 4);
+
+        int                              nThread = -1;
+        int                              i       = -1;
+        float                            fValue  = 0.f;
+        std::basic_string<qx::char_type> sText;
+        std::basic_string<qx::char_type> sString;
+        stringStream >> nThread >> i >> fValue >> sText >> sString;
+
+        ASSERT_GE(nThread, 0);
+        ASSERT_LT(nThread, k_nThreads);
+        EXPECT_EQ(i, nextIterations[nThread]++);
+        EXPECT_EQ(fValue, 0.5f);
+        EXPECT_EQ(sText, QX_TEXT("text"));
+        EXPECT_EQ(sString, QX_TEXT("string"));
+    }
+
+    QX_LOGGER_INSTANCE.reset();
+}
+
+TEST(logger, async_binary_oversized_record)
+{
+    constexpr size_t k_nBufferSize = 256;
+
+    auto        pStream = std::make_unique<test_logger_stream>();
+    const auto& stream  = *pStream;
+    QX_LOGGER_INSTANCE.add_stream(std::move(pStream));
+
+    QX_LOGGER_INSTANCE.enable_async(16, qx::log_queue_overflow_policy::block, k_nBufferSize);
+
+    // a record just over half of the buffer may never fit, so it's dropped instead of blocking forever
+    qx::string sText;
+    while (qx::details::get_binary_log_record_size(sText) <= k_nBufferSize / 2)
+        sText.push_back(QX_TEXT('a'));
+
+    for (int i = 0; i < 3; ++i)
+    {
+        QX_LOG_BINARY(qx::verbosity::log, QX_TEXT("small {}"), i);
+        QX_LOG_BINARY(qx::verbosity::log, QX_TEXT("big {}"), sText);
+    }
+
+    QX_LOGGER_INSTANCE.flush();
+
+    ASSERT_EQ(stream.get_messages().size(), 3);
+    EXPECT_TRUE(stream.get_messages()[2].ends_with(QX_TEXT("small 2\n")));
+    EXPECT_EQ(QX_LOGGER_INSTANCE.get_dropped_messages_count(), 3);
+
+    QX_LOGGER_INSTANCE.reset();
+}
+
+TEST(logger, compile_time_category_verbosity)
+{
+    constexpr qx::category CatWarnings = qx::category(QX_TEXT("CatWarnings")).set_verbosity(qx::verbosity::warning);
+
+    auto  pStream    = std::make_unique<test_logger_stream>();
+    auto* pRawStream = pStream.get();
+    QX_LOGGER_INSTANCE.add_stream(std::move(pStream));
+
+    int  nEvaluations = 0;
+    auto evaluate     = [&nEvaluations]()
+    {
+        return ++nEvaluations;
+    };
+
+    QX_LOG_C(CatWarnings, qx::verbosity::verbose, QX_TEXT("{}"), evaluate());
+    QX_LOG_C(CatWarnings, qx::verbosity::error, QX_TEXT("{}"), evaluate());
+
+    EXPECT_EQ(nEvaluations, 1);
+    EXPECT_EQ(pRawStream->get_messages().size(), 1);
+
+    // macros are single expressions and don't capture the following else
+    bool bElse = false;
+    if (nEvaluations == 0)
+        QX_LOG_C(CatWarnings, qx::verbosity::verbose, QX_TEXT("{}"), evaluate());
+    else
+        bElse = true;
+
+    EXPECT_TRUE(bElse);
+
+    bElse = false;
+    if (nEvaluations == 0)
+        QX_LOG_BINARY_C(CatWarnings, qx::verbosity::error, QX_TEXT("{}"), evaluate());
+    else
+        bElse = true;
+
+    EXPECT_TRUE(bElse);
+    EXPECT_EQ(nEvaluations, 1);
+    EXPECT_EQ(pRawStream->get_messages().size(), 1);
+
+    // runtime calls respect category verbosity too
+    QX_LOGGER_INSTANCE
+        .log(qx::verbosity::log, QX_TEXT("message"), CatWarnings, QX_TEXT("file.cpp"), QX_TEXT("func"), 1);
+    EXPECT_EQ(pRawStream->get_messages().size(), 1);
+
+    QX_LOGGER_INSTANCE.reset();
+}
+
+// the statement is expanded before it's passed on, as in gtest death test macros
+#define TEST_STATEMENT(statement)         statement
+#define TEST_FORWARD_STATEMENT(statement) TEST_STATEMENT(statement)
+
+TEST(logger, rate_limit)
+{
+    u64  nSuppressed = 0;
+    auto Acquire     = [&nSuppressed](auto& limiter)
+    {
+        nSuppressed = 0;
+        return limiter.try_acquire(nSuppressed);
+    };
+
+    qx::log_sampler sampler(2, 3);
+    EXPECT_TRUE(Acquire(sampler));
+    EXPECT_TRUE(Acquire(sampler));
+    EXPECT_FALSE(Acquire(sampler));
+    EXPECT_FALSE(Acquire(sampler));
+    EXPECT_TRUE(Acquire(sampler));
+    EXPECT_EQ(nSuppressed, 2);
+
+    qx::log_rate_limiter limiter(2, std::chrono::milliseconds(100));
+    EXPECT_TRUE(Acquire(limiter));
+    EXPECT_TRUE(Acquire(limiter));
+    EXPECT_FALSE(Acquire(limiter));
+    EXPECT_FALSE(Acquire(limiter));
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    EXPECT_TRUE(Acquire(limiter));
+    EXPECT_EQ(nSuppressed, 2);
+
+    auto  pStream    = std::make_unique<test_logger_stream>();
+    auto* pRawStream = pStream.get();
+    QX_LOGGER_INSTANCE.add_stream(std::move(pStream));
+
+    // suppressed calls are not formatted and their args are not evaluated
+    int  nEvaluations = 0;
+    auto evaluate     = [&nEvaluations](int nValue)
+    {
+        ++nEvaluations;
+        return nValue;
+    };
+
+    for (int i = 0; i < 10; ++i)
+        QX_LOG_SAMPLED(qx::verbosity::log, 2, 4, QX_TEXT("msg {}"), evaluate(i));
+
+    EXPECT_EQ(nEvaluations, 4);
+
+    const auto& messages = pRawStream->get_messages();
+    ASSERT_EQ(messages.size(), 6);
+    EXPECT_TRUE(messages[0].ends_with(QX_TEXT("msg 0\n")));
+    EXPECT_TRUE(messages[1].ends_with(QX_TEXT("msg 1\n")));
+    EXPECT_TRUE(messages[2].ends_with(QX_TEXT("3 similar messages were suppressed\n")));
+    EXPECT_TRUE(messages[3].ends_with(QX_TEXT("msg 5\n")));
+    EXPECT_TRUE(messages[5].ends_with(QX_TEXT("msg 9\n")));
+
+    for (int i = 0; i < 10; ++i)
+        QX_LOG_RATE_LIMITED(qx::verbosity::log, 3, std::chrono::hours(1), QX_TEXT("limited {}"), i);
+
+    EXPECT_EQ(messages.size(), 9);
+    EXPECT_TRUE(messages.back().ends_with(QX_TEXT("limited 2\n")));
+
+    // the macro is a single expression and doesn't capture the following else
+    bool bElse = false;
+    if (messages.empty())
+        QX_LOG_RATE_LIMITED(qx::verbosity::log, 3, std::chrono::hours(1), QX_TEXT("limited"));
+    else
+        bElse = true;
+
+    EXPECT_TRUE(bElse);
+    EXPECT_EQ(messages.size(), 9);
+
+    // the macro has no unparenthesized commas, so it can be forwarded by other macros
+    TEST_FORWARD_STATEMENT(QX_LOG_RATE_LIMITED(qx::verbosity::log, 3, std::chrono::hours(1), QX_TEXT("limited")));
+    EXPECT_EQ(messages.size(), 10);
+    EXPECT_TRUE(messages.back().ends_with(QX_TEXT("limited\n")));
+
+    QX_LOGGER_INSTANCE.reset();
+}
+
+TEST(logger, unit_cache)
+{
+    auto  pFirstStream     = std::make_unique<test_logger_stream>();
+    auto  pSecondStream    = std::make_unique<test_logger_stream>();
+    auto* pRawFirstStream  = pFirstStream.get();
+    auto* pRawSecondStream = pSecondStream.get();
+    QX_LOGGER_INSTANCE.add_stream(std::move(pFirstStream));
+
+    auto log_message = []()
+    {
+        QX_LOG(qx::verbosity::log, QX_TEXT("msg {}"), 1);
+    };
+
+    log_message();
+    log_message();
+    EXPECT_EQ(pRawFirstStream->get_messages().size(), 2);
+
+    // units change must invalidate the call site cache
+    pRawFirstStream->deregister_unit(qx::base_logger_stream::k_svDefaultUnit);
+    pRawFirstStream->register_unit(qx::base_logger_stream::k_svDefaultUnit, { qx::verbosity::warning });
+    log_message();
+    EXPECT_EQ(pRawFirstStream->get_messages().size(), 2);
+
+    // as well as streams change
+    QX_LOGGER_INSTANCE.add_stream(std::move(pSecondStream));
+    log_message();
+    EXPECT_EQ(pRawFirstStream->get_messages().size(), 2);
+    EXPECT_EQ(pRawSecondStream->get_messages().size(), 1);
+
+    pRawFirstStream->deregister_unit(qx::base_logger_stream::k_svDefaultUnit);
+    pRawFirstStream->register_unit(qx::base_logger_stream::k_svDefaultUnit, { qx::verbosity::log });
+    log_message();
+    EXPECT_EQ(pRawFirstStream->get_messages().size(), 3);
+    EXPECT_EQ(pRawSecondStream->get_messages().size(), 2);
+
+    QX_LOGGER_INSTANCE.reset();
+}
+
+TEST(logger, shared_default_line)
+{
+    auto pFirstStream    = std::make_unique<test_logger_stream>();
+    auto pSecondStream   = std::make_unique<test_logger_stream>();
+    auto pPreciseStream  = std::make_unique<test_logger_stream>();
+    auto pPrecise2Stream = std::make_unique<test_logger_stream>();
+    auto pCustomStream   = std::make_unique<test_logger_stream>();
+
+    auto* pRawFirstStream    = pFirstStream.get();
+    auto* pRawSecondStream   = pSecondStream.get();
+    auto* pRawPreciseStream  = pPreciseStream.get();
+    auto* pRawPrecise2Stream = pPrecise2Stream.get();
+    auto* pRawCustomStream   = pCustomStream.get();
+
+    pRawPreciseStream->set_time_precision(qx::log_time_precision::microseconds);
+    pRawPrecise2Stream->set_time_precision(qx::log_time_precision::microseconds);
+
+    qx::log_unit_info customUnit { qx::verbosity::log };
+    customUnit.formatFunc = [](qx::logger_buffer& buffers,
+                               qx::verbosity,
+                               const qx::category&,
+                               qx::string_view,
+                               qx::string_view,
+                               int,
+                               qx::string_view svMessage)
+    {
+        buffers.sMessage = svMessage;
+    };
+    pRawCustomStream->deregister_unit(qx::base_logger_stream::k_svDefaultUnit);
+    pRawCustomStream->register_unit(qx::base_logger_stream::k_svDefaultUnit, customUnit);
+
+    // precisions alternate
+    QX_LOGGER_INSTANCE.add_stream(std::move(pFirstStream));
+    QX_LOGGER_INSTANCE.add_stream(std::move(pPreciseStream));
+    QX_LOGGER_INSTANCE.add_stream(std::move(pCustomStream));
+    QX_LOGGER_INSTANCE.add_stream(std::move(pSecondStream));
+    QX_LOGGER_INSTANCE.add_stream(std::move(pPrecise2Stream));
+
+    nLogLineFormats = 0;
+    for (int i = 0; i < 3; ++i)
+        QX_LOG(qx::verbosity::log, QX_TEXT("shared {}"), i);
+
+    // one line per record and time precision and one for the custom format stream
+    EXPECT_EQ(nLogLineFormats, 3 * 3);
+
+    for (const auto* pStream :
+         { pRawFirstStream, pRawSecondStream, pRawPreciseStream, pRawPrecise2Stream, pRawCustomStream })
+    {
+        ASSERT_EQ(pStream->get_messages().size(), 3);
+    }
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        const qx::string sExpected = qx::string::static_format(QX_TEXT("shared {}"), i);
+
+        EXPECT_TRUE(pRawFirstStream->get_messages()[i].ends_with(sExpected + QX_TEXT("\n")));
+        EXPECT_TRUE(pRawPreciseStream->get_messages()[i].ends_with(sExpected + QX_TEXT("\n")));
+        EXPECT_GT(pRawPreciseStream->get_messages()[i].size(), pRawFirstStream->get_messages()[i].size());
+        EXPECT_EQ(pRawCustomStream->get_messages()[i], sExpected);
+    }
+
+    QX_LOGGER_INSTANCE.reset();
+}
+
+TEST(logger, streams_change_under_load)
+{
+    constexpr int k_nThreads = 4;
+    constexpr int k_nChanges = 200;
+
+    qx::logger        logger;
+    std::atomic<bool> bStop = false;
+
+    std::vector<std::thread> threads;
+    for (int nThread = 0; nThread < k_nThreads; ++nThread)
+    {
+        threads.emplace_back(
+            [&logger, &bStop]()
+            {
+                qx::log_unit_cache unitCache;
+
+                for (int i = 0; !bStop.load(std::memory_order_relaxed); ++i)
+                {
+                    TEST_LOG_VALUE(logger, i);
+                    logger.log(
+                        unitCache,
+                        qx::verbosity::log,
+                        QX_TEXT("cached {}"),
+                        CatDefault,
+                        QX_TEXT("file.cpp"),
+                        QX_TEXT("func"),
+                        1,
+                        i);
+                }
+            });
+    }
+
+    for (int i = 0; i < k_nChanges; ++i)
+    {
+        auto  pStream    = std::make_unique<test_logger_stream>(nullptr, false);
+        auto* pRawStream = pStream.get();
+        logger.add_stream(std::move(pStream));
+
+        // units of a stream which is being used by the logging threads
+        pRawStream->register_unit(QX_TEXT("func"), { qx::verbosity::warning });
+        pRawStream->deregister_unit(QX_TEXT("func"));
+
+        if (i % 10 == 9)
+            logger.reset();
+    }
+
+    auto  pStream    = std::make_unique<test_logger_stream>();
+    auto* pRawStream = pStream.get();
+    logger.add_stream(std::move(pStream));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    bStop = true;
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_FALSE(pRawStream->get_messages().empty());
+    logger.reset();
+}
+
+TEST(logger, rejected_message_is_not_formatted)
+{
+    qx::logger logger;
+
+    auto pStream = std::make_unique<test_logger_stream>();
+    pStream->deregister_unit(qx::base_logger_stream::k_svDefaultUnit);
+    pStream->register_unit(qx::base_logger_stream::k_svDefaultUnit, { qx::verbosity::warning });
+    test_logger_stream* pRawStream = pStream.get();
+    logger.add_stream(std::move(pStream));
+
+    int nFormats = 0;
+
+    logger.log(
+        qx::verbosity::verbose,
+        QX_TEXT("{}"),
+        CatDefault,
+        QX_TEXT("file.cpp"),
+        QX_TEXT("func"),
+        1,
+        format_counter { &nFormats });
+
+    EXPECT_EQ(nFormats, 0);
+    EXPECT_TRUE(pRawStream->get_messages().empty());
+
+    logger.log(
+        qx::verbosity::warning,
+        QX_TEXT("{}"),
+        CatDefault,
+        QX_TEXT("file.cpp"),
+        QX_TEXT("func"),
+        1,
+        format_counter { &nFormats });
+
+    EXPECT_EQ(nFormats, 1);
+    EXPECT_EQ(pRawStream->get_messages().size(), 1);
+}
+
 QX_POP_SUPPRESS_WARNINGS();
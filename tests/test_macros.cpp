@@ -61,6 +61,17 @@ QX_STATIC_ASSERT_STR_EQ(pszFileName, QX_TEXT("test_macros.cpp"));
 
 
 
+// ------------------------------------------------- QX_FUNCTION_NAME --------------------------------------------------
+
+constexpr qx::string_view get_test_function_name()
+{
+    return QX_FUNCTION_NAME;
+}
+
+static_assert(get_test_function_name() == QX_TEXT("get_test_function_name"));
+
+
+
 // ------------------------------------------------- QX_SINGLE_ARGUMENT ------------------------------------------------
 
 #define MACRO_WITH_2_ARGS(a, b) \
@@ -0,0 +1,142 @@
+/**
+
+    @file      test_metrics.cpp
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+#include <common.h>
+
+//V_EXCLUDE_PATH *test_metrics.cpp
+
+#include <qx/stat/metrics.h>
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+QX_DEFINE_CATEGORY(CatMetricsTest, qx::color::white());
+
+namespace
+{
+
+const qx::metric_snapshot* find_metric(const qx::metrics_snapshot& snapshot, std::string_view svName)
+{
+    for (const qx::metric_snapshot& metric : snapshot)
+    {
+        if (metric.sCategory == "CatMetricsTest" && metric.sName == svName)
+            return &metric;
+    }
+
+    return nullptr;
+}
+
+} // namespace
+
+TEST(metrics, histogram_layout)
+{
+    using layout = qx::metric_histogram_layout;
+
+    for (u64 nValue = 0; nValue < 100000; ++nValue)
+    {
+        const size_t nBucket = layout::get_bucket(nValue);
+        EXPECT_LE(layout::get_bucket_lower_bound(nBucket), nValue);
+        EXPECT_GE(layout::get_bucket_upper_bound(nBucket), nValue);
+    }
+
+    EXPECT_EQ(layout::get_bucket(~u64(0)), layout::k_nBuckets - 1);
+    EXPECT_EQ(layout::get_bucket_upper_bound(layout::k_nBuckets - 1), ~u64(0));
+
+    for (size_t nBucket = 1; nBucket < layout::k_nBuckets; ++nBucket)
+        EXPECT_EQ(layout::get_bucket_upper_bound(nBucket - 1) + 1, layout::get_bucket_lower_bound(nBucket));
+}
+
+TEST(metrics, counters_and_histograms_of_threads)
+{
+    constexpr int k_nThreads = 4;
+    constexpr int k_nValues  = 1000;
+
+    const qx::metric_counter   counter(CatMetricsTest, "requests");
+    const qx::metric_histogram histogram(CatMetricsTest, "latency");
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < k_nThreads; ++i)
+    {
+        threads.emplace_back(
+            [&counter, &histogram]()
+            {
+                for (u64 nValue = 1; nValue <= k_nValues; ++nValue)
+                {
+                    counter.add();
+                    histogram.record(nValue);
+                }
+            });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    // the same name is the same metric
+    qx::metric_counter(CatMetricsTest, "requests").add(5);
+
+    const qx::metrics_snapshot snapshot = qx::metrics::collect();
+
+    const qx::metric_snapshot* pCounter = find_metric(snapshot, "requests");
+    ASSERT_TRUE(pCounter);
+    EXPECT_EQ(pCounter->eType, qx::metric_type::counter);
+    EXPECT_EQ(pCounter->nCounter, k_nThreads * k_nValues + 5);
+
+    const qx::metric_snapshot* pHistogram = find_metric(snapshot, "latency");
+    ASSERT_TRUE(pHistogram);
+    EXPECT_EQ(pHistogram->nCount, k_nThreads * k_nValues);
+    EXPECT_EQ(pHistogram->nSum, k_nThreads * k_nValues * (k_nValues + 1) / 2);
+    EXPECT_EQ(pHistogram->nMax, k_nValues);
+    EXPECT_NEAR(static_cast<double>(pHistogram->get_percentile(0.5)), 500.0, 500.0 / 8);
+    EXPECT_NEAR(static_cast<double>(pHistogram->get_percentile(0.99)), 990.0, 990.0 / 8);
+    EXPECT_EQ(pHistogram->get_percentile(1.0), k_nValues);
+}
+
+TEST(metrics, gauge)
+{
+    const qx::metric_gauge gauge(CatMetricsTest, "queue_size");
+    gauge.set(10.0);
+    gauge.add(-3.0);
+
+    const qx::metrics_snapshot snapshot = qx::metrics::collect();
+
+    const qx::metric_snapshot* pGauge = find_metric(snapshot, "queue_size");
+    ASSERT_TRUE(pGauge);
+    EXPECT_DOUBLE_EQ(pGauge->fGauge, 7.0);
+
+    // another type with the same name is rejected
+    qx::metric_counter(CatMetricsTest, "queue_size").add();
+    EXPECT_EQ(qx::metrics::collect().size(), snapshot.size());
+}
+
+TEST(metrics, export)
+{
+    const qx::metric_counter   counter(CatMetricsTest, "exported_counter");
+    const qx::metric_histogram histogram(CatMetricsTest, "exported_histogram");
+    counter.add(42);
+    histogram.record(std::chrono::microseconds(3));
+
+    const qx::metrics_snapshot snapshot = qx::metrics::collect();
+
+    std::ostringstream textStream;
+    qx::export_metrics_text(textStream, snapshot);
+
+    const std::string sText = textStream.str();
+    EXPECT_NE(sText.find("CatMetricsTest/exported_counter counter 42\n"), std::string::npos);
+    EXPECT_NE(sText.find("CatMetricsTest/exported_histogram histogram count=1 mean=3000.0"), std::string::npos);
+
+    std::ostringstream jsonStream;
+    qx::export_metrics_json(jsonStream, snapshot);
+
+    const std::string sJson = jsonStream.str();
+    EXPECT_TRUE(sJson.starts_with("{\"metrics\":["));
+    EXPECT_NE(
+        sJson.find("{\"category\":\"CatMetricsTest\",\"name\":\"exported_counter\",\"type\":\"counter\",\"value\":42}"),
+        std::string::npos);
+    EXPECT_NE(sJson.find("\"count\":1,\"sum\":3000,\"max\":3000"), std::string::npos);
+}
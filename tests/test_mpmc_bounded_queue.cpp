@@ -0,0 +1,119 @@
+/**
+
+    @file      test_mpmc_bounded_queue.cpp
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+#include <common.h>
+
+//V_EXCLUDE_PATH *test_mpmc_bounded_queue.cpp
+
+#include <qx/containers/mpmc_bounded_queue.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(mpmc_bounded_queue, capacity)
+{
+    EXPECT_EQ(qx::mpmc_bounded_queue<int>(1).capacity(), 2);
+    EXPECT_EQ(qx::mpmc_bounded_queue<int>(2).capacity(), 2);
+    EXPECT_EQ(qx::mpmc_bounded_queue<int>(3).capacity(), 4);
+    EXPECT_EQ(qx::mpmc_bounded_queue<int>(1000).capacity(), 1024);
+}
+
+TEST(mpmc_bounded_queue, push_pop)
+{
+    qx::mpmc_bounded_queue<std::string> queue(4);
+    EXPECT_TRUE(queue.empty());
+
+    EXPECT_TRUE(queue.try_push("1"));
+    EXPECT_TRUE(queue.try_push("2"));
+    EXPECT_TRUE(queue.try_push("3"));
+    EXPECT_TRUE(queue.try_push("4"));
+    EXPECT_FALSE(queue.try_push("5"));
+    EXPECT_EQ(queue.size(), 4);
+    EXPECT_FALSE(queue.empty());
+
+    std::string sValue;
+    EXPECT_TRUE(queue.try_pop(sValue));
+    EXPECT_EQ(sValue, "1");
+    EXPECT_TRUE(queue.try_pop(sValue));
+    EXPECT_EQ(sValue, "2");
+
+    EXPECT_TRUE(queue.try_push_with(
+        [](std::string& sCellValue)
+        {
+            sCellValue = "5";
+        }));
+
+    EXPECT_TRUE(queue.try_pop(sValue));
+    EXPECT_EQ(sValue, "3");
+    EXPECT_TRUE(queue.try_pop(sValue));
+    EXPECT_EQ(sValue, "4");
+    EXPECT_TRUE(queue.try_pop_with(
+        [](const std::string& sCellValue)
+        {
+            EXPECT_EQ(sCellValue, "5");
+        }));
+
+    EXPECT_FALSE(queue.try_pop(sValue));
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(mpmc_bounded_queue, multiple_producers)
+{
+    constexpr size_t k_nProducers  = 4;
+    constexpr size_t k_nIterations = 10000;
+
+    qx::mpmc_bounded_queue<size_t> queue(64);
+
+    std::vector<std::thread> producers;
+    for (size_t nProducer = 0; nProducer < k_nProducers; ++nProducer)
+    {
+        producers.emplace_back(
+            [&queue, nProducer]()
+            {
+                for (size_t i = 0; i < k_nIterations; ++i)
+                {
+                    while (!queue.try_push(nProducer * k_nIterations + i))
+                        std::this_thread::yield();
+                }
+            });
+    }
+
+    // every producer's values must come in order
+    std::vector<size_t> lastValues(k_nProducers, 0);
+    std::vector<size_t> counts(k_nProducers, 0);
+
+    size_t nPopped = 0;
+    while (nPopped < k_nProducers * k_nIterations)
+    {
+        size_t nValue = 0;
+        if (!queue.try_pop(nValue))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        const size_t nProducer = nValue / k_nIterations;
+        if (counts[nProducer] > 0)
+        {
+            EXPECT_GT(nValue, lastValues[nProducer]);
+        }
+
+        lastValues[nProducer] = nValue;
+        ++counts[nProducer];
+        ++nPopped;
+    }
+
+    for (auto& producer : producers)
+        producer.join();
+
+    for (size_t nCount : counts)
+        EXPECT_EQ(nCount, k_nIterations);
+
+    EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,125 @@
+/**
+
+    @file      test_perf_mutex.cpp
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+#include <common.h>
+
+//V_EXCLUDE_PATH *test_perf_mutex.cpp
+
+#define QX_CONF_USE_PERF_MUTEX
+
+#include <qx/containers/unique_objects_pool.h>
+
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+
+struct guarded_object
+{
+    QX_PERF_MUTEX(m_TestMutex);
+    QX_PERF_SHARED_MUTEX(m_TestSharedMutex);
+};
+
+} // namespace
+
+TEST(perf_mutex, uncontended)
+{
+    guarded_object object;
+
+    const auto& stats             = object.m_TestMutex.get_stats();
+    const u64   nAcquisitionsFrom = stats.nAcquisitions;
+    const u64   nContendedFrom    = stats.nContendedAcquisitions;
+
+    for (int i = 0; i < 10; ++i)
+        std::lock_guard lock(object.m_TestMutex);
+
+    EXPECT_TRUE(object.m_TestMutex.try_lock());
+    object.m_TestMutex.unlock();
+
+    EXPECT_EQ(stats.nAcquisitions - nAcquisitionsFrom, 11);
+    EXPECT_EQ(stats.nContendedAcquisitions - nContendedFrom, 0);
+}
+
+TEST(perf_mutex, contended)
+{
+    guarded_object object;
+
+    const auto& stats             = object.m_TestMutex.get_stats();
+    const u64   nAcquisitionsFrom = stats.nAcquisitions;
+    const u64   nContendedFrom    = stats.nContendedAcquisitions;
+    const u64   nWaitTicksFrom    = stats.nWaitTicks;
+
+    std::unique_lock lock(object.m_TestMutex);
+
+    std::thread waiter(
+        [&object]
+        {
+            std::lock_guard waiterLock(object.m_TestMutex);
+        });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    lock.unlock();
+    waiter.join();
+
+    EXPECT_EQ(stats.nAcquisitions - nAcquisitionsFrom, 2);
+    EXPECT_EQ(stats.nContendedAcquisitions - nContendedFrom, 1);
+    EXPECT_GT(stats.nWaitTicks - nWaitTicksFrom, 0);
+    EXPECT_GT(qx::perf_mutex_stats::get_percentile(stats.holdHistogram, 1.0), 0);
+}
+
+TEST(perf_mutex, shared)
+{
+    guarded_object object;
+
+    const auto& stats       = object.m_TestSharedMutex.get_stats();
+    const u64   nSharedFrom = stats.nSharedAcquisitions;
+    const u64   nUniqueFrom = stats.nAcquisitions;
+
+    {
+        std::shared_lock lock1(object.m_TestSharedMutex);
+        std::shared_lock lock2(object.m_TestSharedMutex);
+    }
+    {
+        std::unique_lock lock(object.m_TestSharedMutex);
+    }
+
+    EXPECT_EQ(stats.nSharedAcquisitions - nSharedFrom, 2);
+    EXPECT_EQ(stats.nAcquisitions - nUniqueFrom, 1);
+}
+
+TEST(perf_mutex, library_mutexes)
+{
+    qx::unique_objects_pool<std::string> pool;
+
+    const auto token = pool.get_or_create("str");
+    EXPECT_EQ(*token, "str");
+
+    guarded_object object;
+    {
+        std::lock_guard lock(object.m_TestMutex);
+    }
+
+    bool bPoolMutexFound = false;
+    qx::for_each_perf_mutex_stats(
+        [&bPoolMutexFound](std::string_view svName, const qx::perf_mutex_stats& stats)
+        {
+            if (svName == "m_UniqueObjectsPoolMutex")
+                bPoolMutexFound = stats.nAcquisitions > 0;
+        });
+
+    EXPECT_TRUE(bPoolMutexFound);
+
+    std::ostringstream stream;
+    qx::report_perf_mutex_stats(stream);
+
+    const std::string sReport = stream.str();
+    EXPECT_NE(sReport.find("m_TestMutex"), std::string::npos);
+    EXPECT_NE(sReport.find("m_UniqueObjectsPoolMutex"), std::string::npos);
+}
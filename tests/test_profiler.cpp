@@ -0,0 +1,213 @@
+/**
+
+    @file      test_profiler.cpp
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+#include <common.h>
+
+//V_EXCLUDE_PATH *test_profiler.cpp
+
+#define QX_CONF_USE_PROFILER
+
+#include <qx/logger/logger.h>
+#include <qx/profiler/chrome_trace.h>
+#include <qx/profiler/folded_stacks.h>
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+QX_DEFINE_CATEGORY(CatProfilerTest, qx::color::white());
+
+namespace
+{
+
+size_t count_substrings(const std::string& sStr, std::string_view svWhat)
+{
+    size_t nCount = 0;
+    for (size_t nPos = sStr.find(svWhat); nPos != std::string::npos; nPos = sStr.find(svWhat, nPos + 1))
+        ++nCount;
+
+    return nCount;
+}
+
+void recursive_function(int nDepth)
+{
+    QX_PERF_SCOPE();
+
+    if (nDepth > 0)
+        recursive_function(nDepth - 1);
+}
+
+void profiled_function()
+{
+    QX_PERF_SCOPE();
+
+    {
+        QX_PERF_SCOPE(CatProfilerTest, "Inner \"quoted\" scope");
+    }
+}
+
+class null_logger_stream : public qx::base_logger_stream
+{
+public:
+    null_logger_stream() : base_logger_stream(false)
+    {
+    }
+
+    virtual void flush() override
+    {
+    }
+
+private:
+    virtual void do_log(
+        qx::string_view                            svMessage,
+        const qx::log_unit&                        logUnit,
+        const std::vector<qx::logger_color_range>& colors,
+        qx::verbosity                              eVerbosity) override
+    {
+    }
+};
+
+} // namespace
+
+TEST(profiler, chrome_trace)
+{
+    // drop events of previous tests
+    std::ostringstream discardStream;
+    qx::export_chrome_trace(discardStream);
+
+    constexpr int k_nThreads = 4;
+    constexpr int k_nCalls   = 10;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < k_nThreads; ++i)
+    {
+        threads.emplace_back(
+            []()
+            {
+                for (int nCall = 0; nCall < k_nCalls; ++nCall)
+                    profiled_function();
+            });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    std::ostringstream stream;
+    EXPECT_EQ(qx::export_chrome_trace(stream), 2 * k_nThreads * k_nCalls);
+
+    const std::string sTrace = stream.str();
+    EXPECT_TRUE(sTrace.starts_with("{\"traceEvents\":["));
+    EXPECT_EQ(count_substrings(sTrace, "\"name\":\"profiled_function\""), k_nThreads * k_nCalls);
+    EXPECT_EQ(
+        count_substrings(sTrace, "\"name\":\"Inner \\\"quoted\\\" scope\",\"cat\":\"CatProfilerTest\""),
+        k_nThreads * k_nCalls);
+    EXPECT_NE(sTrace.find("\"droppedEvents\":0"), std::string::npos);
+
+    // events are consumed by the export
+    std::ostringstream emptyStream;
+    EXPECT_EQ(qx::export_chrome_trace(emptyStream), 0);
+}
+
+TEST(profiler, stop)
+{
+    std::ostringstream discardStream;
+    qx::export_chrome_trace(discardStream);
+
+    qx::profiler::stop();
+    profiled_function();
+    qx::profiler::start();
+
+    std::ostringstream stream;
+    EXPECT_EQ(qx::export_chrome_trace(stream), 0);
+
+    profiled_function();
+    EXPECT_EQ(qx::export_chrome_trace(stream), 2);
+}
+
+TEST(profiler, library_scopes)
+{
+    std::ostringstream discardStream;
+    qx::export_chrome_trace(discardStream);
+
+    qx::logger logger;
+    logger.add_stream(std::make_unique<null_logger_stream>());
+    logger.log(qx::verbosity::log, QX_TEXT("msg"), CatDefault, QX_TEXT("file.cpp"), QX_TEXT("func"), 1);
+
+    std::ostringstream stream;
+    qx::export_chrome_trace(stream);
+
+    const std::string sTrace = stream.str();
+    EXPECT_NE(sTrace.find("\"name\":\"Resolve log units\",\"cat\":\"CatLogger\""), std::string::npos);
+    EXPECT_NE(sTrace.find("\"name\":\"Log formatting\""), std::string::npos);
+}
+
+TEST(profiler, call_tree)
+{
+    constexpr int k_nThreads = 4;
+    constexpr int k_nCalls   = 10;
+
+    // reset counters of previous tests
+    qx::profiler::collect_call_tree(true);
+    qx::profiler::start_call_tree();
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < k_nThreads; ++i)
+    {
+        threads.emplace_back(
+            []()
+            {
+                for (int nCall = 0; nCall < k_nCalls; ++nCall)
+                    profiled_function();
+
+                recursive_function(2);
+            });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    qx::profiler::stop_call_tree();
+
+    const qx::profiler_call_tree_node callTree = qx::profiler::collect_call_tree();
+
+    const auto itFunction = callTree.children.find("profiled_function");
+    ASSERT_NE(itFunction, callTree.children.end());
+
+    const qx::profiler_call_tree_node& function = *itFunction->second;
+    EXPECT_EQ(function.nCalls, k_nThreads * k_nCalls);
+    ASSERT_EQ(function.children.size(), 1);
+
+    const qx::profiler_call_tree_node& inner = *function.children.begin()->second;
+    EXPECT_EQ(function.children.begin()->first, "Inner \"quoted\" scope");
+    EXPECT_EQ(inner.nCalls, k_nThreads * k_nCalls);
+    EXPECT_LE(inner.nInclusiveTicks, function.nInclusiveTicks);
+    EXPECT_EQ(function.nExclusiveTicks + inner.nInclusiveTicks, function.nInclusiveTicks);
+
+    const auto itRecursive = callTree.children.find("recursive_function");
+    ASSERT_NE(itRecursive, callTree.children.end());
+    const qx::profiler_call_tree_node& recursive = *itRecursive->second;
+    EXPECT_EQ(recursive.nCalls, k_nThreads);
+    EXPECT_EQ(recursive.children.at("recursive_function")->children.at("recursive_function")->nCalls, k_nThreads);
+
+    std::ostringstream stream;
+    qx::export_folded_stacks(stream, callTree);
+
+    const std::string sStacks = stream.str();
+    EXPECT_NE(sStacks.find("profiled_function;Inner \"quoted\" scope "), std::string::npos);
+    EXPECT_NE(sStacks.find("recursive_function;recursive_function;recursive_function "), std::string::npos);
+
+    // counters are reset only on request
+    std::ostringstream keepStream;
+    EXPECT_GT(qx::export_folded_stacks(keepStream), 0);
+
+    std::ostringstream resetStream;
+    EXPECT_GT(qx::export_folded_stacks(resetStream, qx::folded_stacks_value::exclusive_time, true), 0);
+
+    std::ostringstream emptyStream;
+    EXPECT_EQ(qx::export_folded_stacks(emptyStream), 0);
+}
@@ -0,0 +1,119 @@
+/**
+
+    @file      test_rcu.cpp
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+#include <common.h>
+
+//V_EXCLUDE_PATH *test_rcu.cpp
+
+#include <qx/smart_ptr/rcu.h>
+
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+struct rcu_test_data
+{
+    static constexpr int k_nAlive = 0x600d;
+    static constexpr int k_nDead  = 0xdead;
+
+    ~rcu_test_data()
+    {
+        nState = k_nDead;
+    }
+
+    int nState = k_nAlive;
+    int nValue = 0;
+};
+
+} // namespace
+
+TEST(rcu, nested_sections)
+{
+    std::optional<qx::rcu_read_guard> optOuterGuard;
+    optOuterGuard.emplace();
+    {
+        qx::rcu_read_guard innerGuard;
+    }
+
+    // the outer section is still active, another thread must wait for it
+    std::atomic<bool> bSynchronized = false;
+    std::thread       writer(
+        [&bSynchronized]()
+        {
+            qx::rcu_synchronize();
+            bSynchronized = true;
+        });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(bSynchronized);
+
+    optOuterGuard.reset();
+    writer.join();
+    EXPECT_TRUE(bSynchronized);
+}
+
+TEST(rcu, replace_under_load)
+{
+    constexpr int k_nReaders      = 4;
+    constexpr int k_nReplacements = 1000; 
+
+    std::atomic<rcu_test_data*> pData   = new rcu_test_data;
+    std::atomic<bool>           bStop   = false;
+    std::atomic<int>            nErrors = 0;
+    std::atomic<int>            nReady  = 0;
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < k_nReaders; ++i)
+    {
+        readers.emplace_back(
+            [&]()
+            {
+                int nLastValue = 0;
+                ++nReady;
+
+                while (!bStop.load(std::memory_order_relaxed))
+                {
+                    {
+                        qx::rcu_read_guard readGuard;
+
+                        const rcu_test_data* pCurrentData = pData.load(std::memory_order_acquire);
+                        if (pCurrentData->nState != rcu_test_data::k_nAlive || pCurrentData->nValue < nLastValue)
+                            ++nErrors;
+
+                        nLastValue = pCurrentData->nValue;
+                    }
+
+                    std::this_thread::yield();
+                }
+            });
+    }
+
+    while (nReady < k_nReaders)
+        std::this_thread::yield();
+
+    for (int i = 1; i <= k_nReplacements; ++i)
+    {
+        auto pNewData    = std::make_unique<rcu_test_data>();
+        pNewData->nValue = i;
+
+        std::unique_ptr<rcu_test_data> pOldData(pData.exchange(pNewData.release(), std::memory_order_acq_rel));
+        qx::rcu_synchronize();
+    }
+
+    bStop = true;
+    for (auto& reader : readers)
+        reader.join();
+
+    EXPECT_EQ(nErrors, 0);
+    EXPECT_EQ(pData.load()->nValue, k_nReplacements);
+    delete pData.load();
+}
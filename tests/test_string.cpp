@@ -2209,6 +2209,7 @@ TYPED_TEST(TestQxString, rfind)
         EXPECT_EQ(str.rfind(toSearch..., 15), 11);
         EXPECT_EQ(str.rfind(toSearch..., 29, 20), 25);
         EXPECT_EQ(str.rfind(toSearch..., 0), 0);
+        EXPECT_EQ(str.rfind(toSearch..., str.size() + 10), 25);
         EXPECT_EQ(str.rfind(STR("kek")), GTEST_SINGLE_ARGUMENT(StringType::npos));
     };
 
@@ -61,3 +61,27 @@ TEST(string_converters, to_string)
     }
 #endif
 }
+
+TEST(string_converters, encode_utf8)
+{
+    auto Encode = [](auto stringView)
+    {
+        std::string sUtf8(qx::get_max_utf8_size<typename decltype(stringView)::value_type>(stringView.size()), '\0');
+        sUtf8.resize(qx::encode_utf8(stringView, sUtf8.data()));
+        return sUtf8;
+    };
+
+    EXPECT_EQ(Encode(qx::cstring_view("Hello world")), "Hello world");
+    EXPECT_EQ(Encode(qx::wstring_view(L"Hello world")), "Hello world");
+    EXPECT_EQ(Encode(qx::wstring_view(L"")), "");
+
+    // 2, 3 and 4 bytes sequences (a surrogate pair on windows)
+    EXPECT_EQ(Encode(qx::wstring_view(L"\u00e9")), "\xC3\xA9");
+    EXPECT_EQ(Encode(qx::wstring_view(L"\u4e2d")), "\xE4\xB8\xAD");
+    EXPECT_EQ(Encode(qx::wstring_view(L"\U0001F600")), "\xF0\x9F\x98\x80");
+    EXPECT_EQ(Encode(qx::wstring_view(L"a\u00e9b\u4e2dc")), "a\xC3\xA9" "b\xE4\xB8\xAD" "c");
+
+    // lone surrogate
+    const wchar_t szSurrogate[] = { L'a', static_cast<wchar_t>(0xD800), L'b', L'\0' };
+    EXPECT_EQ(Encode(qx::wstring_view(szSurrogate)), "a\xEF\xBF\xBD" "b");
+}
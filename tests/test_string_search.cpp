@@ -0,0 +1,248 @@
+/**
+
+    @file      test_string_search.cpp
+    @author    Khrapov
+    @date      17.10.2026
+    @copyright  Nick Khrapov, 2026. All right reserved.
+
+**/
+#include <common.h>
+
+//V_EXCLUDE_PATH *test_string_search.cpp
+
+#include <qx/containers/string/string_search.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace
+{
+
+constexpr size_t k_nMaxSize = 300;
+
+// long enough for Boyer-Moore-Horspool algorithm
+constexpr size_t k_nMaxSubstringSearchSize = qx::k_nStringLongHaystackSize + 100;
+
+template<class char_t>
+std::vector<char_t> create_text(size_t nSize)
+{
+    std::vector<char_t> text(nSize);
+    for (size_t i = 0; i < nSize; ++i)
+        text[i] = static_cast<char_t>('a' + i % 20);
+
+    return text;
+}
+
+template<class char_t>
+const char_t* reference_find_last_of(const char_t* pBegin, const char_t* pEnd, const char_t* pSet, size_t nSetSize)
+{
+    for (const char_t* pChar = pEnd; pChar > pBegin;)
+    {
+        --pChar;
+        if (std::find(pSet, pSet + nSetSize, *pChar) != pSet + nSetSize)
+            return pChar;
+    }
+
+    return nullptr;
+}
+
+template<class char_t>
+void check_char_search()
+{
+    // every size, every position of the char and a range offset to check all tails and unaligned loads
+    for (size_t nSize = 0; nSize <= k_nMaxSize; ++nSize)
+    {
+        for (size_t nOffset = 0; nOffset < 3 && nOffset <= nSize; ++nOffset)
+        {
+            std::vector<char_t> text   = create_text<char_t>(nSize);
+            const char_t*       pBegin = text.data() + nOffset;
+            const char_t*       pEnd   = text.data() + nSize;
+
+            EXPECT_EQ(qx::find_char(pBegin, pEnd, static_cast<char_t>('#')), nullptr);
+            EXPECT_EQ(qx::rfind_char(pBegin, pEnd, static_cast<char_t>('#')), nullptr);
+
+            for (size_t nPos = nOffset; nPos < nSize; ++nPos)
+            {
+                const char_t chPrev = text[nPos];
+                text[nPos]          = static_cast<char_t>('#');
+
+                EXPECT_EQ(qx::find_char(pBegin, pEnd, static_cast<char_t>('#')), text.data() + nPos);
+                EXPECT_EQ(qx::rfind_char(pBegin, pEnd, static_cast<char_t>('#')), text.data() + nPos);
+
+                text[nPos] = chPrev;
+            }
+
+            for (size_t nSetSize = 0; nSetSize <= qx::k_nStringSimdCharSetSize + 2; ++nSetSize)
+            {
+                std::vector<char_t> set;
+                for (size_t i = 0; i < nSetSize; ++i)
+                    set.push_back(static_cast<char_t>('a' + (i * 7 + nSize) % 26));
+
+                EXPECT_EQ(
+                    qx::find_first_of_chars(pBegin, pEnd, set.data(), set.size()),
+                    std::find_first_of(pBegin, pEnd, set.begin(), set.end()) != pEnd
+                        ? std::find_first_of(pBegin, pEnd, set.begin(), set.end())
+                        : nullptr);
+                EXPECT_EQ(
+                    qx::find_last_of_chars(pBegin, pEnd, set.data(), set.size()),
+                    reference_find_last_of(pBegin, pEnd, set.data(), set.size()));
+            }
+        }
+    }
+}
+
+template<class char_t>
+const char_t* reference_find(const char_t* pBegin, const char_t* pEnd, const char_t* pWhat, size_t nWhatSize)
+{
+    const char_t* pFound = std::search(pBegin, pEnd, pWhat, pWhat + nWhatSize);
+    return pFound != pEnd || nWhatSize == 0 ? pFound : nullptr;
+}
+
+template<class char_t>
+const char_t* reference_rfind(const char_t* pBegin, const char_t* pEnd, const char_t* pWhat, size_t nWhatSize)
+{
+    const char_t* pFound = std::find_end(pBegin, pEnd, pWhat, pWhat + nWhatSize);
+    return pFound != pEnd || nWhatSize == 0 ? pFound : nullptr;
+}
+
+template<class char_t>
+void check_substring_search()
+{
+    // a two letter alphabet gives a lot of partial matches for every algorithm
+    std::vector<char_t> text(k_nMaxSubstringSearchSize);
+    u32                 nState = 1;
+    for (char_t& ch : text)
+    {
+        nState = nState * 1664525 + 1013904223;
+        ch     = static_cast<char_t>(nState >> 31 ? 'a' : 'b');
+    }
+
+    for (size_t nWhatSize = 0; nWhatSize <= qx::k_nStringLongNeedleSize + 10; ++nWhatSize)
+    {
+        for (size_t nWhatPos = 0; nWhatPos + nWhatSize <= text.size(); nWhatPos += 37)
+        {
+            // the needle is taken from the text, so it is found at least once
+            const std::vector<char_t> what(text.begin() + nWhatPos, text.begin() + nWhatPos + nWhatSize);
+
+            for (size_t nSize : { nWhatSize, nWhatSize + 1, nWhatSize + 17, text.size() })
+            {
+                if (nSize > text.size())
+                    continue;
+
+                const char_t* pBegin = text.data();
+                const char_t* pEnd   = text.data() + nSize;
+
+                EXPECT_EQ(
+                    qx::find_substring(pBegin, pEnd, what.data(), what.size()),
+                    reference_find(pBegin, pEnd, what.data(), what.size()));
+                EXPECT_EQ(
+                    qx::rfind_substring(pBegin, pEnd, what.data(), what.size()),
+                    reference_rfind(pBegin, pEnd, what.data(), what.size()));
+            }
+        }
+
+        // a needle which is not in the text
+        std::vector<char_t> what(nWhatSize, static_cast<char_t>('a'));
+        if (!what.empty())
+            what.back() = static_cast<char_t>('#');
+
+        EXPECT_EQ(
+            qx::find_substring(text.data(), text.data() + text.size(), what.data(), what.size()),
+            reference_find(text.data(), text.data() + text.size(), what.data(), what.size()));
+        EXPECT_EQ(
+            qx::rfind_substring(text.data(), text.data() + text.size(), what.data(), what.size()),
+            reference_rfind(text.data(), text.data() + text.size(), what.data(), what.size()));
+    }
+}
+
+} // namespace
+
+TEST(string_search, char)
+{
+    check_char_search<char>();
+}
+
+TEST(string_search, wchar)
+{
+    check_char_search<wchar_t>();
+}
+
+TEST(string_search, char16)
+{
+    check_char_search<char16_t>();
+}
+
+TEST(string_search, substring_char)
+{
+    check_substring_search<char>();
+}
+
+TEST(string_search, substring_wchar)
+{
+    check_substring_search<wchar_t>();
+}
+
+TEST(string_search, substring_char16)
+{
+    check_substring_search<char16_t>();
+}
+
+TEST(string_search, constexpr)
+{
+    constexpr std::string_view svText = "many different words";
+    constexpr std::string_view svSet  = "wfx";
+
+    static_assert(qx::find_char(svText.data(), svText.data() + svText.size(), 'd') == svText.data() + 5);
+    static_assert(qx::rfind_char(svText.data(), svText.data() + svText.size(), 'd') == svText.data() + 18);
+    static_assert(qx::find_char(svText.data(), svText.data() + svText.size(), 'x') == nullptr);
+    static_assert(
+        qx::find_first_of_chars(svText.data(), svText.data() + svText.size(), svSet.data(), svSet.size())
+        == svText.data() + 7);
+    static_assert(
+        qx::find_last_of_chars(svText.data(), svText.data() + svText.size(), svSet.data(), svSet.size())
+        == svText.data() + 15);
+
+    constexpr std::string_view svWhat = "ent words";
+    constexpr std::string_view svLong = "the long text ends with the short one: many different words";
+
+    static_assert(
+        qx::find_substring(svText.data(), svText.data() + svText.size(), svWhat.data(), svWhat.size())
+        == svText.data() + 11);
+    static_assert(
+        qx::rfind_substring(svText.data(), svText.data() + svText.size(), "f", 1) == svText.data() + 8);
+    static_assert(
+        qx::find_substring(svLong.data(), svLong.data() + svLong.size(), svText.data(), svText.size())
+        == svLong.data() + svLong.size() - svText.size());
+    static_assert(
+        qx::rfind_substring(svText.data(), svText.data() + svText.size(), svLong.data(), svLong.size()) == nullptr);
+
+    // a long needle in a long range is searched with Boyer-Moore-Horspool algorithm
+    constexpr auto SearchLongNeedle = [](bool bReverse)
+    {
+        constexpr size_t k_nFirstPos = 500;
+        constexpr size_t k_nLastPos  = 900;
+
+        std::array<char, qx::k_nStringLongHaystackSize + 100> text {};
+        for (size_t i = 0; i < text.size(); ++i)
+            text[i] = static_cast<char>('a' + i % 25);
+
+        // 'z' is not in the rest of the text
+        std::array<char, qx::k_nStringLongNeedleSize + 16> what {};
+        for (size_t i = 0; i < what.size(); ++i)
+            what[i] = i == what.size() / 2 ? 'z' : static_cast<char>('a' + i % 25);
+
+        std::copy(what.begin(), what.end(), text.begin() + k_nFirstPos);
+        std::copy(what.begin(), what.end(), text.begin() + k_nLastPos);
+
+        const char* pBegin = text.data();
+        const char* pEnd   = text.data() + text.size();
+        const char* pFound = bReverse ? qx::rfind_substring(pBegin, pEnd, what.data(), what.size())
+                                      : qx::find_substring(pBegin, pEnd, what.data(), what.size());
+
+        return pFound ? static_cast<size_t>(pFound - pBegin) : text.size();
+    };
+
+    static_assert(SearchLongNeedle(false) == 500);
+    static_assert(SearchLongNeedle(true) == 900);
+}